@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include "maths/collision.h"
+#include "collision_reference.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+struct CollisionCase
+{
+    core::Vec2f velocity1;
+    core::Vec2f velocity2;
+    core::Vec2f normal;
+    float mass1 = 1.0f;
+    float mass2 = 1.0f;
+};
+
+std::vector<CollisionCase> GenerateCases(std::size_t caseNmb)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> velocityDistribution(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> massDistribution(0.1f, 10.0f);
+    std::vector<CollisionCase> cases(caseNmb);
+    for (auto& collisionCase : cases)
+    {
+        collisionCase.velocity1 = { velocityDistribution(generator), velocityDistribution(generator) };
+        collisionCase.velocity2 = { velocityDistribution(generator), velocityDistribution(generator) };
+        collisionCase.normal = core::Vec2f{ velocityDistribution(generator), velocityDistribution(generator) }.GetNormalized();
+        collisionCase.mass1 = massDistribution(generator);
+        collisionCase.mass2 = massDistribution(generator);
+    }
+    return cases;
+}
+}
+
+static void BM_ElasticCollisionTrigonometric(benchmark::State& state)
+{
+    auto cases = GenerateCases(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (auto& collisionCase : cases)
+        {
+            core::SolveElasticCollisionTrigonometric(collisionCase.velocity1, collisionCase.mass1,
+                collisionCase.velocity2, collisionCase.mass2, collisionCase.normal);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ElasticCollisionTrigonometric)->Arg(1'000);
+
+static void BM_ElasticCollision(benchmark::State& state)
+{
+    auto cases = GenerateCases(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (auto& collisionCase : cases)
+        {
+            core::SolveElasticCollision(collisionCase.velocity1, collisionCase.mass1,
+                collisionCase.velocity2, collisionCase.mass2, collisionCase.normal);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ElasticCollision)->Arg(1'000);
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include "engine/component.h"
+#include "engine/entity.h"
+#include "engine/transform.h"
+#include "maths/vec2.h"
+
+#include <vector>
+
+namespace
+{
+constexpr core::EntityMask benchComponentType = 2u;
+
+class BenchComponentManager : public core::ComponentManager<core::Vec2f, benchComponentType>
+{
+public:
+    using ComponentManager::ComponentManager;
+};
+
+void SetupEntities(core::EntityManager& entityManager, BenchComponentManager& componentManager, std::size_t entityNmb)
+{
+    for (std::size_t i = 0; i < entityNmb; i++)
+    {
+        const auto entity = entityManager.CreateEntity();
+        componentManager.AddComponent(entity);
+        componentManager.SetComponent(entity, core::Vec2f(static_cast<float>(i), 1.0f));
+    }
+}
+
+void SetupEntities(core::EntityManager& entityManager, core::TransformManager& transformManager, std::size_t entityNmb)
+{
+    for (std::size_t i = 0; i < entityNmb; i++)
+    {
+        const auto entity = entityManager.CreateEntity();
+        transformManager.AddComponent(entity);
+        transformManager.SetPosition(entity, core::Vec2f(static_cast<float>(i), 1.0f));
+    }
+}
+}
+
+static void BM_ComponentGet(benchmark::State& state)
+{
+    const auto entityNmb = static_cast<std::size_t>(state.range(0));
+    core::EntityManager entityManager(entityNmb);
+    BenchComponentManager componentManager(entityManager);
+    SetupEntities(entityManager, componentManager, entityNmb);
+    for (auto _ : state)
+    {
+        core::Vec2f sum{};
+        for (core::Entity entity = 0; entity < entityNmb; entity++)
+        {
+            sum += componentManager.GetComponent(entity);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(entityNmb));
+}
+BENCHMARK(BM_ComponentGet)->RangeMultiplier(10)->Range(100, 100'000);
+
+static void BM_ComponentSet(benchmark::State& state)
+{
+    const auto entityNmb = static_cast<std::size_t>(state.range(0));
+    core::EntityManager entityManager(entityNmb);
+    BenchComponentManager componentManager(entityManager);
+    SetupEntities(entityManager, componentManager, entityNmb);
+    for (auto _ : state)
+    {
+        for (core::Entity entity = 0; entity < entityNmb; entity++)
+        {
+            componentManager.SetComponent(entity, core::Vec2f(static_cast<float>(entity), 2.0f));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(entityNmb));
+}
+BENCHMARK(BM_ComponentSet)->RangeMultiplier(10)->Range(100, 100'000);
+
+static void BM_ComponentCopyAll(benchmark::State& state)
+{
+    const auto entityNmb = static_cast<std::size_t>(state.range(0));
+    core::EntityManager entityManager(entityNmb);
+    BenchComponentManager componentManager(entityManager);
+    SetupEntities(entityManager, componentManager, entityNmb);
+    //Copying back and forth like the RollbackManager restoring and saving the world
+    const std::vector<core::Vec2f> savedComponents = componentManager.GetAllComponents();
+    for (auto _ : state)
+    {
+        componentManager.CopyAllComponents(savedComponents);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(entityNmb));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(savedComponents.size() * sizeof(core::Vec2f)));
+}
+BENCHMARK(BM_ComponentCopyAll)->RangeMultiplier(10)->Range(100, 100'000);
+
+static void BM_TransformUpdate(benchmark::State& state)
+{
+    const auto entityNmb = static_cast<std::size_t>(state.range(0));
+    core::EntityManager entityManager(entityNmb);
+    core::TransformManager transformManager(entityManager);
+    SetupEntities(entityManager, transformManager, entityNmb);
+    const core::Vec2f velocity(0.1f, 0.2f);
+    for (auto _ : state)
+    {
+        //Moves and turns every transform, like copying the bodies to the transforms each frame
+        for (core::Entity entity = 0; entity < entityNmb; entity++)
+        {
+            transformManager.SetPosition(entity, transformManager.GetPosition(entity) + velocity);
+            transformManager.SetRotation(entity, transformManager.GetRotation(entity) + core::Degree(1.0f));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(entityNmb));
+}
+BENCHMARK(BM_TransformUpdate)->RangeMultiplier(10)->Range(100, 100'000);
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include "engine/entity.h"
+
+#include <vector>
+
+static void BM_CreateEntity(benchmark::State& state)
+{
+    const auto entityNmb = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        //Starts from the default size, so the growth of the arrays is measured too
+        core::EntityManager entityManager;
+        for (std::size_t i = 0; i < entityNmb; i++)
+        {
+            benchmark::DoNotOptimize(entityManager.CreateEntity());
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(entityNmb));
+}
+BENCHMARK(BM_CreateEntity)->RangeMultiplier(10)->Range(100, 100'000);
+
+static void BM_CreateDestroyEntity(benchmark::State& state)
+{
+    const auto entityNmb = static_cast<std::size_t>(state.range(0));
+    core::EntityManager entityManager(entityNmb);
+    std::vector<core::Entity> entities(entityNmb);
+    for (auto _ : state)
+    {
+        //The destroyed entities are recycled from the free list by the next iteration
+        for (auto& entity : entities)
+        {
+            entity = entityManager.CreateEntity();
+        }
+        for (const auto entity : entities)
+        {
+            entityManager.DestroyEntity(entity);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(entityNmb));
+}
+BENCHMARK(BM_CreateDestroyEntity)->RangeMultiplier(10)->Range(100, 100'000);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include "maths/angle.h"
+#include "maths/vec2.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+std::vector<core::Vec2f> GenerateVectors(std::size_t vectorNmb)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+    std::vector<core::Vec2f> vectors(vectorNmb);
+    for (auto& vector : vectors)
+    {
+        vector = { distribution(generator), distribution(generator) };
+    }
+    return vectors;
+}
+}
+
+static void BM_Vec2fRotate(benchmark::State& state)
+{
+    auto vectors = GenerateVectors(static_cast<std::size_t>(state.range(0)));
+    const core::Degree rotation(1.0f);
+    for (auto _ : state)
+    {
+        for (auto& vector : vectors)
+        {
+            vector = vector.Rotate(rotation);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Vec2fRotate)->RangeMultiplier(10)->Range(100, 100'000);
+
+static void BM_Vec2fGetNormalized(benchmark::State& state)
+{
+    const auto vectors = GenerateVectors(static_cast<std::size_t>(state.range(0)));
+    std::vector<core::Vec2f> normalizedVectors(vectors.size());
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < vectors.size(); i++)
+        {
+            normalizedVectors[i] = vectors[i].GetNormalized();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Vec2fGetNormalized)->RangeMultiplier(10)->Range(100, 100'000);
+
+static void BM_Vec2fGetMagnitude(benchmark::State& state)
+{
+    const auto vectors = GenerateVectors(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+        for (const auto& vector : vectors)
+        {
+            sum += vector.GetMagnitude();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Vec2fGetMagnitude)->RangeMultiplier(10)->Range(100, 100'000);
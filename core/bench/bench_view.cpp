@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include "engine/component.h"
+#include "engine/entity.h"
+#include "engine/view.h"
+
+namespace
+{
+constexpr core::EntityMask benchComponentType = 2u;
+constexpr core::EntityMask benchOtherComponentType = 4u;
+constexpr core::EntityMask benchDestroyedType = 8u;
+
+class BenchComponentManager : public core::SparseComponentManager<float, benchComponentType>
+{
+public:
+    using SparseComponentManager::SparseComponentManager;
+};
+
+class BenchOtherComponentManager : public core::SparseComponentManager<float, benchOtherComponentType>
+{
+public:
+    using SparseComponentManager::SparseComponentManager;
+};
+
+/**
+ * \brief Fills the EntityManager with entityNmb entities where one entity out of ratio has both components,
+ * like a few bodies in a world full of effects.
+ */
+void SetupEntities(core::EntityManager& entityManager, BenchComponentManager& componentManager,
+    BenchOtherComponentManager& otherComponentManager, std::size_t entityNmb, std::size_t ratio)
+{
+    for (std::size_t i = 0; i < entityNmb; i++)
+    {
+        const auto entity = entityManager.CreateEntity();
+        if (i % ratio == 0)
+        {
+            componentManager.AddComponent(entity);
+            otherComponentManager.AddComponent(entity);
+        }
+    }
+}
+}
+
+static void BM_HasComponentLoop(benchmark::State& state)
+{
+    const auto entityNmb = static_cast<std::size_t>(state.range(0));
+    core::EntityManager entityManager(entityNmb);
+    BenchComponentManager componentManager(entityManager);
+    BenchOtherComponentManager otherComponentManager(entityManager);
+    SetupEntities(entityManager, componentManager, otherComponentManager, entityNmb, static_cast<std::size_t>(state.range(1)));
+    for (auto _ : state)
+    {
+        for (core::Entity entity = 0; entity < entityManager.GetEntitiesSize(); entity++)
+        {
+            if (!entityManager.HasComponent(entity, benchComponentType | benchOtherComponentType) ||
+                entityManager.HasComponent(entity, benchDestroyedType))
+                continue;
+            auto& value = componentManager.GetComponent(entity);
+            value += otherComponentManager.GetComponent(entity);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(entityNmb));
+}
+BENCHMARK(BM_HasComponentLoop)->ArgsProduct({ {1'000, 10'000}, {1, 16, 256} });
+
+static void BM_View(benchmark::State& state)
+{
+    const auto entityNmb = static_cast<std::size_t>(state.range(0));
+    core::EntityManager entityManager(entityNmb);
+    BenchComponentManager componentManager(entityManager);
+    BenchOtherComponentManager otherComponentManager(entityManager);
+    SetupEntities(entityManager, componentManager, otherComponentManager, entityNmb, static_cast<std::size_t>(state.range(1)));
+    for (auto _ : state)
+    {
+        for (auto [entity, value, otherValue] : core::View(entityManager, componentManager, otherComponentManager)
+            .Exclude(benchDestroyedType))
+        {
+            value += otherValue;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(entityNmb));
+}
+BENCHMARK(BM_View)->ArgsProduct({ {1'000, 10'000}, {1, 16, 256} });
@@ -5,6 +5,8 @@
 #include "utils/assert.h"
 
 #include <cstdint>
+#include <limits>
+#include <vector>
 
 
 namespace core
@@ -32,6 +34,9 @@ template<typename T, Component C>
 class ComponentManager
 {
 public:
+    using Type = T;
+    static constexpr Component COMPONENT_FLAG = C;
+
     ComponentManager(EntityManager& entityManager) : entityManager_(entityManager)
     {
         components_.resize(entityInitNmb);
@@ -152,4 +157,194 @@ void ComponentManager<T, C>::CopyAllComponents(const std::vector<T>& components)
 {
     components_ = components;
 }
+
+/**
+ * \brief PackedComponents is a struct that contains the live components of a SparseComponentManager and their entities.
+ * Both arrays have the same size and order. It is used to copy only the live range of components.
+ * \tparam T type of the component
+ */
+template<typename T>
+struct PackedComponents
+{
+    std::vector<Entity> entities;
+    std::vector<T> components;
+};
+
+/**
+ * \brief SparseComponentManager is a class that owns Component in a sparse set.
+ * Components are packed in a dense array next to their Entity, and a sparse array gives the dense index of an Entity.
+ * Systems can iterate only on the entities that have the component instead of the whole EntityManager.
+ * \tparam T type of the component
+ * \tparam C unique binary flag of the component. This will be set in the EntityMask of the EntityManager when added.
+ */
+template<typename T, Component C>
+class SparseComponentManager
+{
+public:
+    using Type = T;
+    static constexpr Component COMPONENT_FLAG = C;
+
+    SparseComponentManager(EntityManager& entityManager) : entityManager_(entityManager)
+    {
+        sparse_.resize(entityInitNmb, INVALID_INDEX);
+    }
+    virtual ~SparseComponentManager() = default;
+
+    SparseComponentManager(const SparseComponentManager&) = delete;
+    SparseComponentManager& operator=(SparseComponentManager&) = delete;
+    SparseComponentManager(SparseComponentManager&&) = delete;
+    SparseComponentManager& operator=(SparseComponentManager&&) = delete;
+
+    /**
+     * \brief AddComponent is a method that sets the flag C in the EntityManager and appends the component to the dense array.
+     * If the Entity is already in the set, its component is kept.
+     * \param entity will have its flag C added in EntityManager
+     */
+    virtual void AddComponent(Entity entity);
+    /**
+     * \brief RemoveComponent is a method that unsets the flag C in the EntityManager and removes the component by swapping it with the last one.
+     * \param entity will have its flag C removed
+     */
+    virtual void RemoveComponent(Entity entity);
+    /**
+     * \brief RemoveDestroyedEntities is a method that removes the components of the entities that do not have the flag C anymore,
+     * for example when they were destroyed by the EntityManager.
+     */
+    void RemoveDestroyedEntities();
+    [[nodiscard]] const T& GetComponent(Entity entity) const;
+    [[nodiscard]] T& GetComponent(Entity entity);
+    void SetComponent(Entity entity, const T& value);
+    /**
+     * \brief GetAllComponents is a method that returns the dense array of components, in the same order as GetEntities.
+     */
+    [[nodiscard]] const std::vector<T>& GetAllComponents() const { return packed_.components; }
+    /**
+     * \brief GetEntities is a method that returns the dense array of entities that have a component in the set.
+     */
+    [[nodiscard]] const std::vector<Entity>& GetEntities() const { return packed_.entities; }
+    [[nodiscard]] const PackedComponents<T>& GetPackedComponents() const { return packed_; }
+    [[nodiscard]] std::size_t GetSize() const { return packed_.entities.size(); }
+    /**
+     * \brief CopyAllComponents is a method that replaces the set by the given live components.
+     * Only the dense arrays are copied, the sparse array is rebuilt from the entities.
+     * \param packedComponents is the new content of the set
+     */
+    void CopyAllComponents(const PackedComponents<T>& packedComponents);
+protected:
+    using Index = std::uint32_t;
+    static constexpr Index INVALID_INDEX = std::numeric_limits<Index>::max();
+
+    [[nodiscard]] bool Contains(Entity entity) const
+    {
+        return entity < sparse_.size() && sparse_[entity] != INVALID_INDEX;
+    }
+
+    EntityManager& entityManager_;
+    std::vector<Index> sparse_;
+    PackedComponents<T> packed_;
+};
+
+template <typename T, Component C>
+void SparseComponentManager<T, C>::AddComponent(Entity entity)
+{
+    gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
+    //Invalid entity would allocate too much memory
+    if (entity == INVALID_ENTITY)
+        return;
+    if (entity >= sparse_.size())
+    {
+        auto newSize = sparse_.size() < 2 ? 2 : sparse_.size();
+        while (entity >= newSize)
+        {
+            newSize = newSize + newSize / 2;
+        }
+        sparse_.resize(newSize, INVALID_INDEX);
+    }
+    if (sparse_[entity] == INVALID_INDEX)
+    {
+        sparse_[entity] = static_cast<Index>(packed_.entities.size());
+        packed_.entities.push_back(entity);
+        packed_.components.emplace_back();
+    }
+    entityManager_.AddComponent(entity, C);
+}
+
+template <typename T, Component C>
+void SparseComponentManager<T, C>::RemoveComponent(Entity entity)
+{
+    gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
+    gpr_warn(entityManager_.HasComponent(entity, C), "Entity has not the removing component");
+    entityManager_.RemoveComponent(entity, C);
+    if (!Contains(entity))
+        return;
+    const auto index = sparse_[entity];
+    const auto lastEntity = packed_.entities.back();
+    packed_.entities[index] = lastEntity;
+    packed_.components[index] = std::move(packed_.components.back());
+    sparse_[lastEntity] = index;
+    sparse_[entity] = INVALID_INDEX;
+    packed_.entities.pop_back();
+    packed_.components.pop_back();
+}
+
+template <typename T, Component C>
+void SparseComponentManager<T, C>::RemoveDestroyedEntities()
+{
+    for (auto index = packed_.entities.size(); index > 0; index--)
+    {
+        const auto entity = packed_.entities[index - 1];
+        if (entityManager_.HasComponent(entity, C))
+            continue;
+        const auto lastEntity = packed_.entities.back();
+        packed_.entities[index - 1] = lastEntity;
+        packed_.components[index - 1] = std::move(packed_.components.back());
+        sparse_[lastEntity] = static_cast<Index>(index - 1);
+        sparse_[entity] = INVALID_INDEX;
+        packed_.entities.pop_back();
+        packed_.components.pop_back();
+    }
+}
+
+template <typename T, Component C>
+const T& SparseComponentManager<T, C>::GetComponent(Entity entity) const
+{
+    gpr_assert(Contains(entity), "Entity has not the requested component");
+    gpr_warn(entityManager_.HasComponent(entity, C), "Entity has not the requested component");
+    return packed_.components[sparse_[entity]];
+}
+
+template <typename T, Component C>
+T& SparseComponentManager<T, C>::GetComponent(Entity entity)
+{
+    gpr_assert(Contains(entity), "Entity has not the requested component");
+    gpr_warn(entityManager_.HasComponent(entity, C), "Entity has not the requested component");
+    return packed_.components[sparse_[entity]];
+}
+
+template <typename T, Component C>
+void SparseComponentManager<T, C>::SetComponent(Entity entity, const T& value)
+{
+    gpr_assert(Contains(entity), "Entity has not the requested component");
+    gpr_warn(entityManager_.HasComponent(entity, C), "Entity has not the requested component");
+    packed_.components[sparse_[entity]] = value;
+}
+
+template <typename T, Component C>
+void SparseComponentManager<T, C>::CopyAllComponents(const PackedComponents<T>& packedComponents)
+{
+    for (const auto entity : packed_.entities)
+    {
+        sparse_[entity] = INVALID_INDEX;
+    }
+    packed_ = packedComponents;
+    for (Index index = 0; index < packed_.entities.size(); index++)
+    {
+        const auto entity = packed_.entities[index];
+        if (entity >= sparse_.size())
+        {
+            sparse_.resize(entity + entity / 2 + 1, INVALID_INDEX);
+        }
+        sparse_[entity] = index;
+    }
+}
 } // namespace core
@@ -3,6 +3,7 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <limits>
@@ -20,6 +21,11 @@ using Entity = std::uint32_t;
  * It is used to know what Component an Entity has.
  */
 using EntityMask = std::uint32_t;
+/**
+ * \brief Generation is the type used to count how many times an Entity index was destroyed.
+ * An Entity with its Generation identifies one lifetime of the index, so that a stale Entity can be detected after the index is recycled.
+ */
+using Generation = std::uint32_t;
 /**
  * \brief INVALID_ENTITY is a constant that define an invalid Entity.
  */
@@ -28,8 +34,13 @@ constexpr Entity INVALID_ENTITY = std::numeric_limits<Entity>::max();
  * \brief INVALID_ENTITY_MASK is a constant that define an invalid or empty entity mask.
  */
 constexpr EntityMask INVALID_ENTITY_MASK = 0u;
+/**
+ * \brief ENTITY_WORD_SIZE is the number of entities covered by one word of a component bit array.
+ */
+constexpr std::size_t ENTITY_WORD_SIZE = 64;
 /**
  * \brief Manages the entities in an array using bitwise operations to know if it has components.
+ * For each component bit, it also keeps one bit per entity packed in 64 bits words, so that queries can skip 64 entities at a time.
  */
 class EntityManager
 {
@@ -38,7 +49,7 @@ public:
     EntityManager(std::size_t reservedSize);
     /**
      * \brief CreateEntity is a method that will return the next available Entity index.
-     * It will look at the internal entityMasks_ array and give the first one that is free to use.
+     * It pops the last destroyed Entity from the free list in O(1).
      * If none are free, the array is reallocated.
      * \return the newly created Entity
      */
@@ -46,10 +57,22 @@ public:
     /**
      * \brief DestroyEntity is a method that will erase all Component from the EntityMask.
      * It means that EntityExists will be false and that HasComponent will always return false.
+     * The Generation of the Entity is incremented and its index is pushed on the free list.
      * It will not do anything to the actual ComponentManager.
      * \param entity is the mask that will be voided
      */
     void DestroyEntity(Entity entity);
+    /**
+     * \brief GetGeneration is a method that returns the current Generation of an Entity index.
+     */
+    [[nodiscard]] Generation GetGeneration(Entity entity) const;
+    /**
+     * \brief IsEntityValid is a method that checks if an Entity still exists and was not recycled since it was created.
+     * \param entity is the Entity that we check
+     * \param generation is the Generation of the Entity when it was created
+     * \return false if the Entity was destroyed, even if its index was given to a new Entity
+     */
+    [[nodiscard]] bool IsEntityValid(Entity entity, Generation generation) const;
     /**
      * \brief AddComponent is a method that adds the bitwise entity mask to the entity mask.
      * It is normally called by the ComponentManager. 
@@ -81,10 +104,36 @@ public:
      * \return the total size of the EntityMask array.
      */
     [[nodiscard]] std::size_t GetEntitiesSize() const;
+    /**
+     * \brief GetComponentWord is a method that returns which entities have all the bits of mask on,
+     * for the ENTITY_WORD_SIZE entities starting at wordIndex * ENTITY_WORD_SIZE.
+     * \param wordIndex is the index of the word
+     * \param mask is the Component bitwise mask to check
+     * \return a word where the bit i is on if the Entity wordIndex * ENTITY_WORD_SIZE + i has the mask on
+     */
+    [[nodiscard]] std::uint64_t GetComponentWord(std::size_t wordIndex, EntityMask mask) const;
+    /**
+     * \brief GetAnyComponentWord is a method that returns which entities have at least one bit of mask on,
+     * for the ENTITY_WORD_SIZE entities starting at wordIndex * ENTITY_WORD_SIZE.
+     */
+    [[nodiscard]] std::uint64_t GetAnyComponentWord(std::size_t wordIndex, EntityMask mask) const;
+    /**
+     * \brief GetWordsSize is a method that returns the number of words needed to cover all the entities.
+     */
+    [[nodiscard]] std::size_t GetWordsSize() const { return (entityMasks_.size() + ENTITY_WORD_SIZE - 1) / ENTITY_WORD_SIZE; }
 
 
 private:
+    void Resize(std::size_t newSize);
+    void SetComponentBits(Entity entity, EntityMask mask, bool value);
+
     std::vector<EntityMask> entityMasks_;
+    std::vector<Generation> generations_;
+    /**
+     * \brief freeEntities_ is a stack of the free Entity indices, the next created Entity is at the back.
+     */
+    std::vector<Entity> freeEntities_;
+    std::array<std::vector<std::uint64_t>, sizeof(EntityMask) * 8> componentWords_;
 };
 
 } // namespace core
@@ -0,0 +1,58 @@
+#pragma once
+#include <engine/entity.h>
+#include "maths/vec2.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace core
+{
+/**
+ * \brief GridBroadPhase is a class that finds the candidate pairs of circle colliders with a uniform grid
+ * covering an area centered on the origin.
+ * Cells are two times the largest radius plus a margin, and colliders outside of the area are clamped to the border cells,
+ * so two colliders that touch, or that would touch after moving less than the margin in total, are in neighbouring cells.
+ */
+class GridBroadPhase
+{
+public:
+    explicit GridBroadPhase(Vec2f areaSize);
+    /**
+     * \brief Clear is a method that removes all the colliders, keeping the buffers.
+     */
+    void Clear();
+    /**
+     * \brief AddCollider is a method that adds a collider, by increasing entity.
+     */
+    void AddCollider(Entity entity, Vec2f position, float radius);
+    /**
+     * \brief BuildPairs is a method that fills the pairs of colliders in neighbouring cells.
+     * Pairs are sorted by first entity, then by second entity, like in an all-pairs loop.
+     * \param minMargin is the smallest margin, it is at least the largest radius
+     */
+    void BuildPairs(float minMargin = 0.0f);
+    [[nodiscard]] const std::vector<std::pair<Entity, Entity>>& GetPairs() const { return pairs_; }
+    /**
+     * \brief GetMargin is a method that returns how far two colliders can move in total after BuildPairs,
+     * while the pair of any two of them that touch is still found.
+     */
+    [[nodiscard]] float GetMargin() const { return cellSize_ - 2.0f * maxRadius_; }
+private:
+    struct Collider
+    {
+        Entity entity = INVALID_ENTITY;
+        Vec2f position{};
+        std::uint32_t cell = 0;
+    };
+
+    Vec2f areaSize_;
+    float maxRadius_ = 0.0f;
+    float cellSize_ = 0.1f;
+    //Kept between builds to avoid allocations
+    std::vector<Collider> colliders_;
+    std::vector<std::uint32_t> cellStarts_;
+    std::vector<Entity> cellEntities_;
+    std::vector<std::pair<Entity, Entity>> pairs_;
+};
+}
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <SFML/System/Time.hpp>
-#include <SFML/Window/Event.hpp>
+
+namespace sf
+{
+class Event;
+}
 
 namespace core
 {
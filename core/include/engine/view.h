@@ -0,0 +1,132 @@
+/**
+ * \file view.h
+ */
+#pragma once
+
+#include "engine/component.h"
+#include "engine/entity.h"
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+
+namespace core
+{
+/**
+ * \brief View is a class that iterates over the entities that have the components of all the given managers.
+ * It scans the component bit words of the EntityManager, skipping 64 entities at a time when none of them match.
+ * Entities are visited by increasing index and dereferencing gives the Entity with references to its components.
+ * Each visit looks up the sparse index of every manager, so loops over a single SparseComponentManager
+ * walk its dense arrays instead, and View is kept for the queries on several components.
+ * \tparam Managers types of the ComponentManager or SparseComponentManager of the required components
+ */
+template<typename... Managers>
+class View
+{
+public:
+    explicit View(EntityManager& entityManager, Managers&... managers) :
+        entityManager_(entityManager), managers_(managers...)
+    {
+    }
+
+    /**
+     * \brief Exclude is a method that returns a copy of the View that skips the entities having any bit of mask on.
+     * \param mask is the Component bitwise mask to exclude, for example the destroyed flag
+     */
+    [[nodiscard]] View Exclude(EntityMask mask) const
+    {
+        View view = *this;
+        view.excludedMask_ |= mask;
+        return view;
+    }
+
+    class Iterator
+    {
+    public:
+        using value_type = std::tuple<Entity, typename Managers::Type&...>;
+
+        /**
+         * \brief Iterator constructor that points to the first matching Entity, or to the end when isEnd is true.
+         */
+        Iterator(const View& view, bool isEnd) : view_(&view), wordsSize_(view.entityManager_.GetWordsSize())
+        {
+            if (isEnd || wordsSize_ == 0)
+            {
+                wordIndex_ = END_INDEX;
+                return;
+            }
+            word_ = view_->GetWord(wordIndex_);
+            SkipEmptyWords();
+        }
+
+        [[nodiscard]] Entity GetEntity() const
+        {
+            return static_cast<Entity>(wordIndex_ * ENTITY_WORD_SIZE + std::countr_zero(word_));
+        }
+
+        value_type operator*() const
+        {
+            const auto entity = GetEntity();
+            return value_type(entity, std::get<Managers&>(view_->managers_).GetComponent(entity)...);
+        }
+
+        Iterator& operator++()
+        {
+            //Clear the lowest set bit
+            word_ &= word_ - 1;
+            SkipEmptyWords();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return wordIndex_ == other.wordIndex_ && word_ == other.word_;
+        }
+
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    private:
+        void SkipEmptyWords()
+        {
+            while (word_ == 0 && ++wordIndex_ < wordsSize_)
+            {
+                word_ = view_->GetWord(wordIndex_);
+            }
+            if (word_ == 0)
+            {
+                wordIndex_ = END_INDEX;
+            }
+        }
+
+        static constexpr std::size_t END_INDEX = std::numeric_limits<std::size_t>::max();
+        const View* view_ = nullptr;
+        std::size_t wordsSize_ = 0;
+        std::size_t wordIndex_ = 0;
+        std::uint64_t word_ = 0;
+    };
+
+    [[nodiscard]] Iterator begin() const { return Iterator(*this, false); }
+    [[nodiscard]] Iterator end() const { return Iterator(*this, true); }
+private:
+    [[nodiscard]] std::uint64_t GetWord(std::size_t wordIndex) const
+    {
+        auto word = entityManager_.GetComponentWord(wordIndex, includedMask_);
+        if (excludedMask_ != INVALID_ENTITY_MASK)
+        {
+            word &= ~entityManager_.GetAnyComponentWord(wordIndex, excludedMask_);
+        }
+        return word;
+    }
+
+    static constexpr EntityMask ComputeIncludedMask()
+    {
+        constexpr EntityMask mask = (INVALID_ENTITY_MASK | ... | static_cast<EntityMask>(Managers::COMPONENT_FLAG));
+        return mask == INVALID_ENTITY_MASK ? static_cast<EntityMask>(ComponentType::EMPTY) : mask;
+    }
+
+    EntityManager& entityManager_;
+    std::tuple<Managers&...> managers_;
+    EntityMask includedMask_ = ComputeIncludedMask();
+    EntityMask excludedMask_ = INVALID_ENTITY_MASK;
+};
+} // namespace core
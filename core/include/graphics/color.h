@@ -1,8 +1,12 @@
 #pragma once
 
-#include <SFML/Graphics/Color.hpp>
 #include <cstdint>
 
+namespace sf
+{
+class Color;
+}
+
 namespace core
 {
 /**
@@ -18,7 +22,7 @@ struct Color
     constexpr Color(std::uint8_t red, std::uint8_t green, std::uint8_t blue, std::uint8_t alpha = 255u) :
         r(red), g(green), b(blue), a(alpha) {}
 
-    operator sf::Color() const { return { r, g, b, a }; }
+    operator sf::Color() const;
 
     static constexpr Color red() { return { 255u,0u,0u,255u }; }
     static constexpr Color green() { return { 0u,255u,0u,255u }; }
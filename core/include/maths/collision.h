@@ -0,0 +1,25 @@
+/**
+ * \file collision.h
+ */
+#pragma once
+
+#include <maths/fixed_vec2.h>
+#include <maths/vec2.h>
+
+namespace core
+{
+/**
+ * \brief SolveElasticCollision is a function that computes the velocities of two bodies after a perfectly elastic collision.
+ * Only the velocity components along the contact normal are exchanged, using dot products and no trigonometry.
+ * \param velocity1 is the velocity of the first body, replaced by its velocity after the collision
+ * \param mass1 is the mass of the first body
+ * \param velocity2 is the velocity of the second body, replaced by its velocity after the collision
+ * \param mass2 is the mass of the second body
+ * \param normal is the normalized contact normal, its sign does not matter
+ */
+void SolveElasticCollision(Vec2f& velocity1, float mass1, Vec2f& velocity2, float mass2, Vec2f normal);
+/**
+ * \brief Fixed point version of SolveElasticCollision.
+ */
+void SolveElasticCollision(FixedVec2& velocity1, Fixed mass1, FixedVec2& velocity2, Fixed mass2, FixedVec2 normal);
+}
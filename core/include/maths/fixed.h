@@ -0,0 +1,133 @@
+/**
+ * \file fixed.h
+ */
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+
+#include "utils/assert.h"
+
+namespace core
+{
+/**
+ * \brief Fixed is a Q16.16 fixed point number (16 integer bits, 16 fractional bits).
+ * All its operations are done with integers, so they give the same bits on every compiler and platform,
+ * unlike float where x87/SSE, FMA contraction or the math library can change the last bits.
+ * It can be implicitly built from float, double and int, but it must be explicitly converted back with ToFloat().
+ * Additions and subtractions wrap around on overflow, like the unsigned integers, instead of being undefined behavior.
+ */
+class Fixed
+{
+public:
+    using Raw = std::int32_t;
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr Raw ONE = Raw{ 1 } << FRACTION_BITS;
+
+    constexpr Fixed() = default;
+    constexpr Fixed(float value) : raw_(static_cast<Raw>(value * static_cast<float>(ONE) + (value >= 0.0f ? 0.5f : -0.5f))){}
+    constexpr Fixed(double value) : raw_(static_cast<Raw>(value * static_cast<double>(ONE) + (value >= 0.0 ? 0.5 : -0.5))){}
+    static constexpr int MAX_INT = std::numeric_limits<Raw>::max() >> FRACTION_BITS;
+    static constexpr int MIN_INT = std::numeric_limits<Raw>::lowest() >> FRACTION_BITS;
+    constexpr Fixed(int value) : raw_(static_cast<Raw>(static_cast<std::uint32_t>(value) << FRACTION_BITS))
+    {
+        if (value < MIN_INT || value > MAX_INT)
+        {
+            gpr_assert(false, "Integer out of the Q16.16 range");
+        }
+    }
+
+    /**
+     * \brief FromRaw builds a Fixed from its underlying Q16.16 integer
+     */
+    static constexpr Fixed FromRaw(Raw raw)
+    {
+        Fixed f;
+        f.raw_ = raw;
+        return f;
+    }
+    [[nodiscard]] constexpr Raw raw() const { return raw_; }
+    [[nodiscard]] constexpr float ToFloat() const { return static_cast<float>(raw_) / static_cast<float>(ONE); }
+    explicit constexpr operator float() const { return ToFloat(); }
+
+    constexpr auto operator<=>(const Fixed&) const = default;
+
+    constexpr Fixed operator-() const { return FromRaw(static_cast<Raw>(0u - static_cast<std::uint32_t>(raw_))); }
+    constexpr Fixed& operator+=(Fixed f) { return *this = *this + f; }
+    constexpr Fixed& operator-=(Fixed f) { return *this = *this - f; }
+    constexpr Fixed& operator*=(Fixed f) { return *this = *this * f; }
+    constexpr Fixed& operator/=(Fixed f) { return *this = *this / f; }
+
+    //Computed on unsigned integers, whose overflow is defined, and converted back modulo 2^32
+    friend constexpr Fixed operator+(Fixed a, Fixed b)
+    {
+        return FromRaw(static_cast<Raw>(static_cast<std::uint32_t>(a.raw_) + static_cast<std::uint32_t>(b.raw_)));
+    }
+    friend constexpr Fixed operator-(Fixed a, Fixed b)
+    {
+        return FromRaw(static_cast<Raw>(static_cast<std::uint32_t>(a.raw_) - static_cast<std::uint32_t>(b.raw_)));
+    }
+    friend constexpr Fixed operator*(Fixed a, Fixed b)
+    {
+        return FromRaw(static_cast<Raw>((static_cast<std::int64_t>(a.raw_) * b.raw_) >> FRACTION_BITS));
+    }
+    /**
+     * \brief Division by zero saturates to the largest (or lowest) value instead of trapping.
+     */
+    friend constexpr Fixed operator/(Fixed a, Fixed b)
+    {
+        if (b.raw_ == 0)
+        {
+            return FromRaw(a.raw_ >= 0 ? std::numeric_limits<Raw>::max() : std::numeric_limits<Raw>::lowest());
+        }
+        return FromRaw(static_cast<Raw>(static_cast<std::int64_t>(a.raw_) * ONE / b.raw_));
+    }
+private:
+    Raw raw_ = 0;
+};
+
+constexpr Fixed Abs(Fixed v)
+{
+    return v < Fixed() ? -v : v;
+}
+
+/**
+ * \brief SqrtInteger is the integer square root, rounded down.
+ */
+std::uint64_t SqrtInteger(std::uint64_t value);
+
+/**
+ * \brief Sqrt is a deterministic square root on Q16.16 numbers.
+ * \param v is the input value, negative values return zero
+ * \return the square root of v, rounded down
+ */
+Fixed Sqrt(Fixed v);
+
+/**
+ * \brief Sin is a deterministic sinus on Q16.16 numbers.
+ * \param degrees is the given angle in degrees
+ * \return the result of the sinus of the angle
+ */
+Fixed Sin(Fixed degrees);
+
+/**
+ * \brief Cos is a deterministic cosinus on Q16.16 numbers.
+ * \param degrees is the given angle in degrees
+ * \return the result of the cosinus of the angle
+ */
+Fixed Cos(Fixed degrees);
+
+/**
+ * \brief Atan2 is a deterministic atan2 on Q16.16 numbers.
+ * \param y is the upper value of the ratio
+ * \param x is the lower value of the ratio
+ * \return the angle in degrees, between -180 and 180
+ */
+Fixed Atan2(Fixed y, Fixed x);
+
+/**
+ * \brief GetPosAngle wraps an angle in degrees between 0 and 360.
+ */
+Fixed GetPosAngle(Fixed degrees);
+}
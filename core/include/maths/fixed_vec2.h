@@ -0,0 +1,57 @@
+/**
+ * \file fixed_vec2.h
+ */
+#pragma once
+
+#include <maths/fixed.h>
+#include <maths/vec2.h>
+
+namespace core
+{
+/**
+ * \brief FixedVec2 is the Q16.16 fixed point counterpart of Vec2f, with the same interface.
+ * Rotations are given in degrees.
+ */
+struct FixedVec2
+{
+    Fixed x, y;
+
+    constexpr FixedVec2() = default;
+    constexpr FixedVec2(Fixed newX, Fixed newY) : x(newX), y(newY)
+    {
+
+    }
+    explicit constexpr FixedVec2(Vec2f v) : x(v.x), y(v.y)
+    {
+
+    }
+
+    [[nodiscard]] constexpr Vec2f ToVec2f() const { return { x.ToFloat(), y.ToFloat() }; }
+
+    [[nodiscard]] Fixed GetMagnitude() const;
+    void Normalize();
+    [[nodiscard]] FixedVec2 GetNormalized() const;
+    [[nodiscard]] Fixed GetSqrMagnitude() const;
+    [[nodiscard]] FixedVec2 Rotate(Fixed degrees) const;
+    static Fixed Dot(FixedVec2 a, FixedVec2 b);
+    static FixedVec2 Lerp(FixedVec2 a, FixedVec2 b, Fixed t);
+
+    FixedVec2 operator+(FixedVec2 v) const;
+    FixedVec2& operator+=(FixedVec2 v);
+    FixedVec2 operator-(FixedVec2 v) const;
+    FixedVec2& operator-=(FixedVec2 v);
+    FixedVec2 operator*(Fixed f) const;
+    FixedVec2 operator/(Fixed f) const;
+    bool operator==(const FixedVec2& v) const = default;
+
+    static constexpr FixedVec2 zero() { return {}; }
+    static constexpr FixedVec2 one() { return {1,1}; }
+    static constexpr FixedVec2 up() { return {0,1}; }
+    static constexpr FixedVec2 down() { return {0,-1}; }
+    static constexpr FixedVec2 left() { return {-1,0}; }
+    static constexpr FixedVec2 right() { return {1,0}; }
+};
+
+FixedVec2 operator*(Fixed f, FixedVec2 v);
+
+}
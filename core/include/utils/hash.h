@@ -0,0 +1,78 @@
+/**
+ * \file hash.h
+ */
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace core
+{
+/**
+ * \brief Hash64 is an incremental 64-bit hash, based on the 8 bytes rounds and the avalanche of xxHash64.
+ * Values are added one by one, so structs can be hashed field by field without hashing their padding.
+ */
+class Hash64
+{
+public:
+    constexpr Hash64() = default;
+    explicit constexpr Hash64(std::uint64_t seed) : acc_(seed + PRIME5){}
+
+    /**
+     * \brief Add is a method that mixes a value of at most 8 bytes into the hash.
+     * Floating point zeros are hashed the same whatever their sign.
+     * \tparam T is a trivially copyable type, without padding if it is not arithmetic
+     */
+    template<typename T>
+    void Add(T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(std::uint64_t));
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (value == T{})
+            {
+                value = T{};
+            }
+        }
+        else
+        {
+            static_assert(std::has_unique_object_representations_v<T>, "Hash the fields of types with padding");
+        }
+        std::uint64_t word = 0;
+        std::memcpy(&word, &value, sizeof(T));
+        AddWord(word);
+    }
+
+    constexpr void AddWord(std::uint64_t word)
+    {
+        word *= PRIME2;
+        word = std::rotl(word, 31);
+        word *= PRIME1;
+        acc_ ^= word;
+        acc_ = std::rotl(acc_, 27) * PRIME1 + PRIME4;
+        length_ += sizeof(word);
+    }
+
+    [[nodiscard]] constexpr std::uint64_t GetDigest() const
+    {
+        std::uint64_t hash = acc_ + length_;
+        hash ^= hash >> 33;
+        hash *= PRIME2;
+        hash ^= hash >> 29;
+        hash *= PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+private:
+    static constexpr std::uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+    static constexpr std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr std::uint64_t PRIME3 = 0x165667B19E3779F9ull;
+    static constexpr std::uint64_t PRIME4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr std::uint64_t PRIME5 = 0x27D4EB2F165667C5ull;
+
+    std::uint64_t acc_ = PRIME5;
+    std::uint64_t length_ = 0;
+};
+}
@@ -0,0 +1,65 @@
+/**
+ * \file spsc_ring.h
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace core
+{
+/**
+ * \brief SpscRing is a lock-free ring of fixed size for one producer thread and one consumer thread.
+ * Pushing and popping never allocate nor block, a push fails when the ring is full.
+ * \tparam T type of the values, copied in and out of the ring
+ * \tparam Capacity number of values the ring can hold, a power of two
+ */
+template<typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity needs to be a power of two");
+public:
+    /**
+     * \brief TryPush is a method called by the producer thread to add a value at the end of the ring.
+     * \return false if the ring is full, the value is then not added
+     */
+    bool TryPush(const T& value)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+        values_[tail & (Capacity - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    /**
+     * \brief TryPop is a method called by the consumer thread to take the oldest value of the ring.
+     * \return false if the ring is empty
+     */
+    bool TryPop(T& value)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = values_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    [[nodiscard]] bool IsEmpty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] static constexpr std::size_t GetCapacity() { return Capacity; }
+private:
+    //The indices only grow, they are wrapped when accessing the values
+    //Each index is written by one thread, so they are kept on different cache lines
+    alignas(64) std::atomic<std::size_t> head_ = 0;
+    alignas(64) std::atomic<std::size_t> tail_ = 0;
+    alignas(64) std::array<T, Capacity> values_{};
+};
+}
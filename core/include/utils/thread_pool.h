@@ -0,0 +1,50 @@
+/**
+ * \file thread_pool.h
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core
+{
+/**
+ * \brief ThreadPool is a fixed set of worker threads that run batches of indexed tasks.
+ * The calling thread takes part in each batch, so a pool with zero workers runs everything inline.
+ */
+class ThreadPool
+{
+public:
+    explicit ThreadPool(std::size_t workerNmb);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * \brief ParallelFor is a method that calls task once for each index in [0, count) on the workers and the calling thread.
+     * It returns when all the calls are done. The same index is never given to two threads.
+     */
+    void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    [[nodiscard]] std::size_t GetWorkerNmb() const { return workers_.size(); }
+private:
+    void Loop();
+    void RunTasks();
+
+    std::vector<std::thread> workers_;
+    std::mutex m_;
+    std::condition_variable startCv_;
+    std::condition_variable doneCv_;
+    const std::function<void(std::size_t)>* task_ = nullptr;
+    std::size_t taskCount_ = 0;
+    std::atomic<std::size_t> nextTask_ = 0;
+    std::size_t busyWorkerNmb_ = 0;
+    std::uint64_t batch_ = 0;
+    bool isOver_ = false;
+};
+}
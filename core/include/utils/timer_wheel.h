@@ -0,0 +1,72 @@
+/**
+ * \file timer_wheel.h
+ */
+#pragma once
+
+#include <SFML/System/Time.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace core
+{
+/**
+ * \brief TimerWheel is a hashed timing wheel: timers are put in the slot of the tick they expire on,
+ * so scheduling, cancelling and advancing the time do not depend on the number of timers.
+ * Timers that expire more than one revolution ahead stay in their slot until their tick comes.
+ */
+class TimerWheel
+{
+public:
+    using TimerId = std::uint32_t;
+    static constexpr TimerId INVALID_TIMER_ID = 0;
+    using Callback = std::function<void()>;
+
+    /**
+     * \param resolution is the duration of one tick, timers are rounded up to it
+     * \param slotNmb is the number of slots of the wheel
+     */
+    explicit TimerWheel(sf::Time resolution, std::size_t slotNmb = 256);
+
+    /**
+     * \brief Schedule is a method that calls callback after delay, and then every period if it is not zero.
+     * \return the id of the timer, used to cancel it
+     */
+    TimerId Schedule(sf::Time delay, Callback callback, sf::Time period = sf::Time());
+
+    void Cancel(TimerId timerId);
+
+    /**
+     * \brief Advance is a method that moves the wheel forward by elapsed and calls the timers that expired.
+     * Callbacks can schedule and cancel timers.
+     */
+    void Advance(sf::Time elapsed);
+
+    /**
+     * \brief GetTimeUntilNextTimer is a method that returns the time before the next timer expires,
+     * or a negative time if no timer is scheduled.
+     */
+    [[nodiscard]] sf::Time GetTimeUntilNextTimer() const;
+
+    [[nodiscard]] std::size_t GetTimerNmb() const { return timers_.size(); }
+private:
+    struct Timer
+    {
+        Callback callback;
+        std::uint64_t expireTick = 0;
+        std::uint64_t periodTicks = 0;
+    };
+    [[nodiscard]] std::uint64_t ToTicks(sf::Time time) const;
+    void Insert(TimerId timerId, std::uint64_t expireTick);
+
+    std::vector<std::vector<TimerId>> slots_;
+    std::unordered_map<TimerId, Timer> timers_;
+    std::vector<TimerId> expiredSlot_;
+    std::int64_t resolution_;
+    std::int64_t elapsed_ = 0;
+    std::uint64_t currentTick_ = 0;
+    TimerId nextTimerId_ = INVALID_TIMER_ID + 1;
+};
+}
@@ -3,61 +3,77 @@
 #include "utils/assert.h"
 
 #include <algorithm>
+#include <bit>
 
 namespace core
 {
 EntityManager::EntityManager()
 {
-    entityMasks_.resize(entityInitNmb, INVALID_ENTITY_MASK);
+    Resize(entityInitNmb);
 }
 
 EntityManager::EntityManager(std::size_t reservedSize)
 {
-    entityMasks_.resize(reservedSize, INVALID_ENTITY_MASK);
+    Resize(reservedSize);
 }
 
 Entity EntityManager::CreateEntity()
 {
-    const auto entityMaskIt = std::find_if(entityMasks_.begin(), entityMasks_.end(),
-        [](EntityMask entityMask)
-        {
-            return entityMask == INVALID_ENTITY_MASK;
-        });
-
-    if (entityMaskIt == entityMasks_.end())
+    if (freeEntities_.empty())
     {
-        const auto newEntity = entityMasks_.size();
-        entityMasks_.resize(newEntity + newEntity / 2, INVALID_ENTITY_MASK);
-        AddComponent(
-            static_cast<Entity>(newEntity),
-            static_cast<EntityMask>(ComponentType::EMPTY));
-        return static_cast<Entity>(newEntity);
+        const auto size = entityMasks_.size();
+        Resize(std::max(size + size / 2, size + 1));
     }
-    
-    const auto newEntity = std::distance(entityMasks_.begin(), entityMaskIt);
+    const auto newEntity = freeEntities_.back();
+    freeEntities_.pop_back();
     AddComponent(
-        static_cast<Entity>(newEntity), 
+        newEntity,
         static_cast<EntityMask>(ComponentType::EMPTY));
-    return static_cast<Entity>(newEntity);
+    return newEntity;
 }
 
 void EntityManager::DestroyEntity(Entity entity)
 {
     gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
+    //Destroying twice would put the same index twice on the free list
+    if (entityMasks_[entity] == INVALID_ENTITY_MASK)
+    {
+        gpr_warn(false, "Destroying an Entity that does not exist");
+        return;
+    }
+    SetComponentBits(entity, entityMasks_[entity], false);
     entityMasks_[entity] = INVALID_ENTITY_MASK;
+    generations_[entity]++;
+    freeEntities_.push_back(entity);
+}
+
+Generation EntityManager::GetGeneration(Entity entity) const
+{
+    gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
+    return generations_[entity];
+}
+
+bool EntityManager::IsEntityValid(Entity entity, Generation generation) const
+{
+    if (entity == INVALID_ENTITY || entity >= entityMasks_.size())
+    {
+        return false;
+    }
+    return entityMasks_[entity] != INVALID_ENTITY_MASK && generations_[entity] == generation;
 }
 
 void EntityManager::AddComponent(Entity entity, EntityMask mask)
 {
     gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
     entityMasks_[entity] |= mask;
+    SetComponentBits(entity, mask, true);
 }
 
 void EntityManager::RemoveComponent(Entity entity, EntityMask mask)
 {
     gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
     entityMasks_[entity] &= ~mask;
-
+    SetComponentBits(entity, mask, false);
 }
 
 bool EntityManager::EntityExists(Entity entity) const
@@ -76,4 +92,54 @@ bool EntityManager::HasComponent(Entity entity, EntityMask mask) const
     gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
     return (entityMasks_[entity] & mask) == mask;
 }
+
+std::uint64_t EntityManager::GetComponentWord(std::size_t wordIndex, EntityMask mask) const
+{
+    std::uint64_t word = ~std::uint64_t(0);
+    while (mask != INVALID_ENTITY_MASK)
+    {
+        word &= componentWords_[std::countr_zero(mask)][wordIndex];
+        mask &= mask - 1;
+    }
+    return word;
+}
+
+std::uint64_t EntityManager::GetAnyComponentWord(std::size_t wordIndex, EntityMask mask) const
+{
+    std::uint64_t word = 0;
+    while (mask != INVALID_ENTITY_MASK)
+    {
+        word |= componentWords_[std::countr_zero(mask)][wordIndex];
+        mask &= mask - 1;
+    }
+    return word;
+}
+
+void EntityManager::Resize(std::size_t newSize)
+{
+    const auto oldSize = entityMasks_.size();
+    entityMasks_.resize(newSize, INVALID_ENTITY_MASK);
+    generations_.resize(newSize, 0);
+    //New indices are pushed in reverse so that they are created in increasing order
+    for (auto entity = newSize; entity > oldSize; entity--)
+    {
+        freeEntities_.push_back(static_cast<Entity>(entity - 1));
+    }
+    for (auto& words : componentWords_)
+    {
+        words.resize(GetWordsSize(), 0);
+    }
+}
+
+void EntityManager::SetComponentBits(Entity entity, EntityMask mask, bool value)
+{
+    const auto wordIndex = entity / ENTITY_WORD_SIZE;
+    const auto bit = std::uint64_t(1) << (entity % ENTITY_WORD_SIZE);
+    while (mask != INVALID_ENTITY_MASK)
+    {
+        auto& word = componentWords_[std::countr_zero(mask)][wordIndex];
+        word = value ? word | bit : word & ~bit;
+        mask &= mask - 1;
+    }
+}
 }
@@ -0,0 +1,98 @@
+#include <engine/grid_broad_phase.h>
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace core
+{
+GridBroadPhase::GridBroadPhase(Vec2f areaSize) : areaSize_(areaSize)
+{
+}
+
+void GridBroadPhase::Clear()
+{
+    colliders_.clear();
+    pairs_.clear();
+    maxRadius_ = 0.0f;
+}
+
+void GridBroadPhase::AddCollider(Entity entity, Vec2f position, float radius)
+{
+    colliders_.push_back({ entity, position, 0 });
+    maxRadius_ = std::max(maxRadius_, radius);
+}
+
+void GridBroadPhase::BuildPairs(float minMargin)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    pairs_.clear();
+    //Cells are larger than two colliders, the rest is the margin the colliders can move after the build
+    cellSize_ = std::max({ 3.0f * maxRadius_, 2.0f * maxRadius_ + minMargin, 0.1f });
+    if (colliders_.size() < 2)
+    {
+        return;
+    }
+
+    const auto columns = std::max(static_cast<std::int32_t>(std::ceil(areaSize_.x / cellSize_)), 1);
+    const auto rows = std::max(static_cast<std::int32_t>(std::ceil(areaSize_.y / cellSize_)), 1);
+    //Colliders outside of the area are clamped to the border cells, which keeps neighbours adjacent
+    const auto getCell = [this, columns, rows](const Vec2f position)
+    {
+        const auto x = std::clamp(static_cast<std::int32_t>(std::floor((position.x + areaSize_.x / 2.0f) / cellSize_)), 0, columns - 1);
+        const auto y = std::clamp(static_cast<std::int32_t>(std::floor((position.y + areaSize_.y / 2.0f) / cellSize_)), 0, rows - 1);
+        return static_cast<std::uint32_t>(y * columns + x);
+    };
+
+    //Counting sort of the colliders by cell, entities stay in increasing order inside a cell
+    cellStarts_.assign(static_cast<std::size_t>(columns * rows) + 1, 0);
+    for (auto& collider : colliders_)
+    {
+        collider.cell = getCell(collider.position);
+        cellStarts_[collider.cell + 1]++;
+    }
+    for (std::size_t cell = 1; cell < cellStarts_.size(); cell++)
+    {
+        cellStarts_[cell] += cellStarts_[cell - 1];
+    }
+    cellEntities_.resize(colliders_.size());
+    for (const auto& collider : colliders_)
+    {
+        cellEntities_[cellStarts_[collider.cell]++] = collider.entity;
+    }
+    //The counting pass moved each start to the end of its cell, shift them back
+    for (std::size_t cell = cellStarts_.size() - 1; cell > 0; cell--)
+    {
+        cellStarts_[cell] = cellStarts_[cell - 1];
+    }
+    cellStarts_[0] = 0;
+
+    for (const auto& collider : colliders_)
+    {
+        const auto pairsBegin = pairs_.size();
+        const std::int32_t cellX = static_cast<std::int32_t>(collider.cell) % columns;
+        const std::int32_t cellY = static_cast<std::int32_t>(collider.cell) / columns;
+        for (std::int32_t y = std::max(cellY - 1, 0); y <= std::min(cellY + 1, rows - 1); y++)
+        {
+            for (std::int32_t x = std::max(cellX - 1, 0); x <= std::min(cellX + 1, columns - 1); x++)
+            {
+                const auto cell = static_cast<std::size_t>(y * columns + x);
+                for (auto i = cellStarts_[cell]; i < cellStarts_[cell + 1]; i++)
+                {
+                    if (cellEntities_[i] > collider.entity)
+                    {
+                        pairs_.emplace_back(collider.entity, cellEntities_[i]);
+                    }
+                }
+            }
+        }
+        //Same order as an all-pairs loop: by first entity, then by second entity
+        std::sort(pairs_.begin() + static_cast<std::ptrdiff_t>(pairsBegin), pairs_.end());
+    }
+}
+}
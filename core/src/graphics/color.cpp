@@ -0,0 +1,11 @@
+#include <graphics/color.h>
+
+#include <SFML/Graphics/Color.hpp>
+
+namespace core
+{
+Color::operator sf::Color() const
+{
+    return { r, g, b, a };
+}
+}
@@ -1,5 +1,6 @@
 #include <graphics/sprite.h>
 #include <engine/transform.h>
+#include <engine/view.h>
 
 namespace core
 {
@@ -15,29 +16,26 @@ void SpriteManager::SetTexture(Entity entity, const sf::Texture& texture)
 
 void SpriteManager::Draw(sf::RenderTarget& window)
 {
-    for (Entity entity = 0; entity < components_.size(); entity++)
+    for (auto [entity, sprite] : View(entityManager_, *this))
     {
-        if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SPRITE)))
+        if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::POSITION)))
         {
-            if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::POSITION)))
-            {
-                const auto position = transformManager_.GetPosition(entity);
-                components_[entity].setPosition(
-                    position.x * pixelPerMeter + center_.x,
-                    windowSize_.y - (position.y * pixelPerMeter + center_.y));
-            }
-            if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SCALE)))
-            {
-                const auto scale = transformManager_.GetScale(entity);
-                components_[entity].setScale(scale);
-            }
-            if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::ROTATION)))
-            {
-                const auto rotation = transformManager_.GetRotation(entity);
-                components_[entity].setRotation(rotation.value());
-            }
-            window.draw(components_[entity]);
+            const auto position = transformManager_.GetPosition(entity);
+            sprite.setPosition(
+                position.x * pixelPerMeter + center_.x,
+                windowSize_.y - (position.y * pixelPerMeter + center_.y));
         }
+        if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SCALE)))
+        {
+            const auto scale = transformManager_.GetScale(entity);
+            sprite.setScale(scale);
+        }
+        if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::ROTATION)))
+        {
+            const auto rotation = transformManager_.GetRotation(entity);
+            sprite.setRotation(rotation.value());
+        }
+        window.draw(sprite);
     }
 }
 
@@ -0,0 +1,21 @@
+#include <maths/collision.h>
+
+namespace core
+{
+void SolveElasticCollision(Vec2f& velocity1, float mass1, Vec2f& velocity2, float mass2, Vec2f normal)
+{
+    //1D elastic collision along the normal, the tangential components are unchanged
+    const float relativeNormalVelocity = Vec2f::Dot(velocity1 - velocity2, normal);
+    const float totalMass = mass1 + mass2;
+    velocity1 -= normal * (2.0f * mass2 / totalMass * relativeNormalVelocity);
+    velocity2 += normal * (2.0f * mass1 / totalMass * relativeNormalVelocity);
+}
+
+void SolveElasticCollision(FixedVec2& velocity1, Fixed mass1, FixedVec2& velocity2, Fixed mass2, FixedVec2 normal)
+{
+    const Fixed relativeNormalVelocity = FixedVec2::Dot(velocity1 - velocity2, normal);
+    const Fixed totalMass = mass1 + mass2;
+    velocity1 -= normal * (2 * mass2 / totalMass * relativeNormalVelocity);
+    velocity2 += normal * (2 * mass1 / totalMass * relativeNormalVelocity);
+}
+}
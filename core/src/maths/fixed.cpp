@@ -0,0 +1,165 @@
+#include <maths/fixed.h>
+
+namespace core
+{
+namespace
+{
+// The polynomials are evaluated with 30 fractional bits, so that their error stays below the Q16.16 precision
+constexpr int POLY_BITS = 30;
+constexpr std::int64_t POLY_ONE = std::int64_t{ 1 } << POLY_BITS;
+
+constexpr std::int64_t ToPoly(double value)
+{
+    return static_cast<std::int64_t>(value * static_cast<double>(POLY_ONE) + (value >= 0.0 ? 0.5 : -0.5));
+}
+
+constexpr std::int64_t PolyMul(std::int64_t a, std::int64_t b)
+{
+    return (a * b) >> POLY_BITS;
+}
+
+constexpr double PI_DOUBLE = 3.14159265358979323846;
+constexpr Fixed::Raw DEGREES_90 = 90 * Fixed::ONE;
+constexpr Fixed::Raw DEGREES_180 = 180 * Fixed::ONE;
+constexpr Fixed::Raw DEGREES_360 = 360 * Fixed::ONE;
+
+// Q16.16 degrees to 30 bits radians: raw * DEGREE_TO_RADIAN >> DEGREE_TO_RADIAN_SHIFT
+constexpr int DEGREE_TO_RADIAN_SHIFT = 32;
+constexpr std::int64_t DEGREE_TO_RADIAN = static_cast<std::int64_t>(
+    PI_DOUBLE / 180.0 * static_cast<double>(std::int64_t{ 1 } << (POLY_BITS - Fixed::FRACTION_BITS + DEGREE_TO_RADIAN_SHIFT)) + 0.5);
+// 30 bits radians to Q16.16 degrees: radian * RADIAN_TO_DEGREE >> RADIAN_TO_DEGREE_SHIFT
+constexpr int RADIAN_TO_DEGREE_SHIFT = 38;
+constexpr std::int64_t RADIAN_TO_DEGREE = static_cast<std::int64_t>(
+    180.0 / PI_DOUBLE * static_cast<double>(std::int64_t{ 1 } << (RADIAN_TO_DEGREE_SHIFT + Fixed::FRACTION_BITS - POLY_BITS)) + 0.5);
+
+/**
+ * \brief Sinus of an angle between -90 and 90 degrees, with a Taylor series up to x^9.
+ */
+Fixed SinQuarter(Fixed::Raw degrees)
+{
+    const std::int64_t x = (static_cast<std::int64_t>(degrees) * DEGREE_TO_RADIAN) >> DEGREE_TO_RADIAN_SHIFT;
+    const std::int64_t x2 = PolyMul(x, x);
+    std::int64_t result = ToPoly(1.0 / 362880.0);
+    result = ToPoly(-1.0 / 5040.0) + PolyMul(x2, result);
+    result = ToPoly(1.0 / 120.0) + PolyMul(x2, result);
+    result = ToPoly(-1.0 / 6.0) + PolyMul(x2, result);
+    result = POLY_ONE + PolyMul(x2, result);
+    result = PolyMul(x, result);
+    constexpr int shift = POLY_BITS - Fixed::FRACTION_BITS;
+    return Fixed::FromRaw(static_cast<Fixed::Raw>((result + (std::int64_t{ 1 } << (shift - 1))) >> shift));
+}
+
+/**
+ * \brief Arc tangent in radians (30 fractional bits) of a ratio between 0 and 1 (30 fractional bits).
+ * Abramowitz and Stegun 4.4.49, error below 2e-8.
+ */
+std::int64_t AtanUnit(std::int64_t z)
+{
+    const std::int64_t z2 = PolyMul(z, z);
+    std::int64_t result = ToPoly(0.0028662257);
+    result = ToPoly(-0.0161657367) + PolyMul(z2, result);
+    result = ToPoly(0.0429096138) + PolyMul(z2, result);
+    result = ToPoly(-0.0752896400) + PolyMul(z2, result);
+    result = ToPoly(0.1065626393) + PolyMul(z2, result);
+    result = ToPoly(-0.1420889944) + PolyMul(z2, result);
+    result = ToPoly(0.1999355085) + PolyMul(z2, result);
+    result = ToPoly(-0.3333314528) + PolyMul(z2, result);
+    result = POLY_ONE + PolyMul(z2, result);
+    return PolyMul(z, result);
+}
+}
+
+std::uint64_t SqrtInteger(std::uint64_t value)
+{
+    std::uint64_t result = 0;
+    std::uint64_t bit = std::uint64_t{ 1 } << 62;
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+Fixed Sqrt(const Fixed v)
+{
+    if (v.raw() <= 0)
+    {
+        return {};
+    }
+    const auto value = static_cast<std::uint64_t>(v.raw()) << Fixed::FRACTION_BITS;
+    return Fixed::FromRaw(static_cast<Fixed::Raw>(SqrtInteger(value)));
+}
+
+Fixed Sin(const Fixed degrees)
+{
+    Fixed::Raw angle = GetPosAngle(degrees).raw();
+    // Fold the angle between -90 and 90 degrees
+    if (angle > DEGREES_180 + DEGREES_90)
+    {
+        angle -= DEGREES_360;
+    }
+    else if (angle > DEGREES_90)
+    {
+        angle = DEGREES_180 - angle;
+    }
+    return SinQuarter(angle);
+}
+
+Fixed Cos(const Fixed degrees)
+{
+    return Sin(degrees + Fixed::FromRaw(DEGREES_90));
+}
+
+Fixed Atan2(const Fixed y, const Fixed x)
+{
+    const std::int64_t absX = x.raw() < 0 ? -static_cast<std::int64_t>(x.raw()) : x.raw();
+    const std::int64_t absY = y.raw() < 0 ? -static_cast<std::int64_t>(y.raw()) : y.raw();
+    if (absX == 0 && absY == 0)
+    {
+        return {};
+    }
+    // Reduce to the first octant, where the ratio is between 0 and 1
+    std::int64_t radian;
+    if (absY <= absX)
+    {
+        radian = AtanUnit((absY << POLY_BITS) / absX);
+    }
+    else
+    {
+        radian = ToPoly(PI_DOUBLE / 2.0) - AtanUnit((absX << POLY_BITS) / absY);
+    }
+    auto degrees = static_cast<Fixed::Raw>((radian * RADIAN_TO_DEGREE) >> RADIAN_TO_DEGREE_SHIFT);
+    if (x.raw() < 0)
+    {
+        degrees = DEGREES_180 - degrees;
+    }
+    if (y.raw() < 0)
+    {
+        degrees = -degrees;
+    }
+    return Fixed::FromRaw(degrees);
+}
+
+Fixed GetPosAngle(const Fixed degrees)
+{
+    Fixed::Raw angle = degrees.raw() % DEGREES_360;
+    if (angle < 0)
+    {
+        angle += DEGREES_360;
+    }
+    return Fixed::FromRaw(angle);
+}
+}
@@ -0,0 +1,105 @@
+#include <maths/fixed_vec2.h>
+
+namespace core
+{
+namespace
+{
+/**
+ * \brief Squared magnitude with 32 fractional bits, so that small vectors keep their precision.
+ */
+std::uint64_t GetSqrMagnitudeRaw(const FixedVec2 v)
+{
+    const std::int64_t x = v.x.raw();
+    const std::int64_t y = v.y.raw();
+    return static_cast<std::uint64_t>(x * x) + static_cast<std::uint64_t>(y * y);
+}
+}
+
+FixedVec2 FixedVec2::operator+(FixedVec2 v) const
+{
+    return {x + v.x, y + v.y};
+}
+
+FixedVec2& FixedVec2::operator+=(FixedVec2 v)
+{
+    x += v.x;
+    y += v.y;
+    return *this;
+}
+
+FixedVec2 FixedVec2::operator-(FixedVec2 v) const
+{
+    return {x - v.x, y - v.y};
+}
+
+FixedVec2& FixedVec2::operator-=(FixedVec2 v)
+{
+    x -= v.x;
+    y -= v.y;
+    return *this;
+}
+
+FixedVec2 FixedVec2::operator*(Fixed f) const
+{
+    return {x * f, y * f};
+}
+
+FixedVec2 FixedVec2::operator/(Fixed f) const
+{
+    return {x / f, y / f};
+}
+
+FixedVec2 operator*(Fixed f, FixedVec2 v)
+{
+    return v * f;
+}
+
+Fixed FixedVec2::GetMagnitude() const
+{
+    // The square root of a value with 32 fractional bits has 16 fractional bits
+    const std::uint64_t result = SqrtInteger(GetSqrMagnitudeRaw(*this));
+    return Fixed::FromRaw(static_cast<Fixed::Raw>(result));
+}
+
+void FixedVec2::Normalize()
+{
+    *this = GetNormalized();
+}
+
+FixedVec2 FixedVec2::GetNormalized() const
+{
+    const auto magnitude = GetMagnitude();
+    // A null vector stays null instead of becoming NaN like Vec2f
+    if (magnitude == Fixed())
+    {
+        return zero();
+    }
+    return (*this) / magnitude;
+}
+
+Fixed FixedVec2::GetSqrMagnitude() const
+{
+    return x * x + y * y;
+}
+
+FixedVec2 FixedVec2::Rotate(Fixed degrees) const
+{
+    const auto cs = Cos(degrees);
+    const auto sn = Sin(degrees);
+
+    FixedVec2 v;
+    v.x = x * cs - y * sn;
+    v.y = x * sn + y * cs;
+    return v;
+}
+
+Fixed FixedVec2::Dot(FixedVec2 a, FixedVec2 b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+FixedVec2 FixedVec2::Lerp(FixedVec2 a, FixedVec2 b, Fixed t)
+{
+    return a + (b - a) * t;
+}
+}
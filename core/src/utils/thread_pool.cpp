@@ -0,0 +1,94 @@
+#include <utils/thread_pool.h>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace core
+{
+ThreadPool::ThreadPool(std::size_t workerNmb)
+{
+    workers_.reserve(workerNmb);
+    for (std::size_t i = 0; i < workerNmb; i++)
+    {
+        workers_.emplace_back(&ThreadPool::Loop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_);
+        isOver_ = true;
+    }
+    startCv_.notify_all();
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (workers_.empty() || count <= 1)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            task(i);
+        }
+        return;
+    }
+    {
+        std::lock_guard lock(m_);
+        task_ = &task;
+        taskCount_ = count;
+        nextTask_.store(0, std::memory_order_relaxed);
+        busyWorkerNmb_ = workers_.size();
+        batch_++;
+    }
+    startCv_.notify_all();
+    RunTasks();
+
+    std::unique_lock lock(m_);
+    doneCv_.wait(lock, [this] { return busyWorkerNmb_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::Loop()
+{
+    std::uint64_t lastBatch = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_);
+            startCv_.wait(lock, [this, lastBatch] { return isOver_ || batch_ != lastBatch; });
+            if (isOver_)
+            {
+                return;
+            }
+            lastBatch = batch_;
+        }
+        RunTasks();
+        {
+            std::lock_guard lock(m_);
+            busyWorkerNmb_--;
+            if (busyWorkerNmb_ == 0)
+            {
+                doneCv_.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::RunTasks()
+{
+    for (auto i = nextTask_.fetch_add(1, std::memory_order_relaxed); i < taskCount_;
+        i = nextTask_.fetch_add(1, std::memory_order_relaxed))
+    {
+        (*task_)(i);
+    }
+}
+}
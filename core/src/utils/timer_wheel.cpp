@@ -0,0 +1,129 @@
+#include <utils/timer_wheel.h>
+#include <utils/assert.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace core
+{
+TimerWheel::TimerWheel(sf::Time resolution, std::size_t slotNmb) :
+    slots_(slotNmb), resolution_(std::max<std::int64_t>(1, resolution.asMicroseconds()))
+{
+    gpr_assert(slotNmb > 0, "Timer wheel needs at least one slot");
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(sf::Time delay, Callback callback, sf::Time period)
+{
+    const auto timerId = nextTimerId_++;
+    if (nextTimerId_ == INVALID_TIMER_ID)
+    {
+        nextTimerId_++;
+    }
+    auto& timer = timers_[timerId];
+    timer.callback = std::move(callback);
+    timer.periodTicks = period.asMicroseconds() > 0 ? std::max<std::uint64_t>(1, ToTicks(period)) : 0;
+    Insert(timerId, currentTick_ + std::max<std::uint64_t>(1, ToTicks(delay)));
+    return timerId;
+}
+
+void TimerWheel::Cancel(TimerId timerId)
+{
+    //The id stays in its slot and is skipped when the slot expires
+    timers_.erase(timerId);
+}
+
+void TimerWheel::Advance(sf::Time elapsed)
+{
+    elapsed_ += elapsed.asMicroseconds();
+    while (elapsed_ >= resolution_)
+    {
+        elapsed_ -= resolution_;
+        currentTick_++;
+        auto& slot = slots_[currentTick_ % slots_.size()];
+        if (slot.empty())
+        {
+            continue;
+        }
+        expiredSlot_.clear();
+        std::swap(expiredSlot_, slot);
+        for (const auto timerId : expiredSlot_)
+        {
+            auto it = timers_.find(timerId);
+            if (it == timers_.end())
+            {
+                continue;
+            }
+            if (it->second.expireTick > currentTick_)
+            {
+                slot.push_back(timerId);
+                continue;
+            }
+            if (it->second.periodTicks != 0)
+            {
+                Insert(timerId, currentTick_ + it->second.periodTicks);
+                //The callback can add timers and rehash the map, or cancel its own timer
+                auto callback = std::move(it->second.callback);
+                callback();
+                it = timers_.find(timerId);
+                if (it != timers_.end())
+                {
+                    it->second.callback = std::move(callback);
+                }
+            }
+            else
+            {
+                const auto callback = std::move(it->second.callback);
+                timers_.erase(it);
+                callback();
+            }
+        }
+    }
+}
+
+sf::Time TimerWheel::GetTimeUntilNextTimer() const
+{
+    if (timers_.empty())
+    {
+        return sf::microseconds(-1);
+    }
+    std::uint64_t nextTick = std::numeric_limits<std::uint64_t>::max();
+    //Look for the first slot with a timer expiring in this revolution, before checking all the timers
+    for (std::uint64_t tick = currentTick_ + 1; tick <= currentTick_ + slots_.size(); tick++)
+    {
+        for (const auto timerId : slots_[tick % slots_.size()])
+        {
+            const auto it = timers_.find(timerId);
+            if (it != timers_.end() && it->second.expireTick == tick)
+            {
+                nextTick = tick;
+                break;
+            }
+        }
+        if (nextTick != std::numeric_limits<std::uint64_t>::max())
+        {
+            break;
+        }
+    }
+    if (nextTick == std::numeric_limits<std::uint64_t>::max())
+    {
+        for (const auto& [timerId, timer] : timers_)
+        {
+            nextTick = std::min(nextTick, timer.expireTick);
+        }
+    }
+    const auto ticks = static_cast<std::int64_t>(nextTick - currentTick_);
+    return sf::microseconds(std::max<std::int64_t>(0, ticks * resolution_ - elapsed_));
+}
+
+std::uint64_t TimerWheel::ToTicks(sf::Time time) const
+{
+    const auto microseconds = std::max<std::int64_t>(0, time.asMicroseconds());
+    return static_cast<std::uint64_t>((microseconds + resolution_ - 1) / resolution_);
+}
+
+void TimerWheel::Insert(TimerId timerId, std::uint64_t expireTick)
+{
+    timers_[timerId].expireTick = expireTick;
+    slots_[expireTick % slots_.size()].push_back(timerId);
+}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "maths/angle.h"
+#include "maths/vec2.h"
+
+#include <cmath>
+
+namespace core
+{
+/**
+ * \brief SolveElasticCollisionTrigonometric is the reference angle based elastic collision,
+ * as it was computed in the game physics before SolveElasticCollision. It is shared by the tests and the benchmarks.
+ */
+inline void SolveElasticCollisionTrigonometric(Vec2f& velocity1, float m1, Vec2f& velocity2, float m2, Vec2f normal)
+{
+    const float v1 = velocity1.GetMagnitude();
+    const float v2 = velocity2.GetMagnitude();
+
+    const float theta1 = std::atan2(velocity1.y, velocity1.x);
+    const float theta2 = std::atan2(velocity2.y, velocity2.x);
+
+    const float phi = std::atan2(normal.y, normal.x);
+
+    const float v1fx = ((v1 * std::cos(theta1 - phi) * (m1 - m2) + 2 * m2 * v2 * std::cos(theta2 - phi)) / (m1 + m2))
+        * std::cos(phi) + v1 * std::sin(theta1 - phi) * std::cos(phi + PI / 2);
+    const float v1fy = ((v1 * std::cos(theta1 - phi) * (m1 - m2) + 2 * m2 * v2 * std::cos(theta2 - phi)) / (m1 + m2))
+        * std::sin(phi) + v1 * std::sin(theta1 - phi) * std::sin(phi + PI / 2);
+
+    const float v2fx = ((v2 * std::cos(theta2 - phi) * (m2 - m1) + 2 * m1 * v1 * std::cos(theta1 - phi)) / (m2 + m1))
+        * std::cos(phi) + v2 * std::sin(theta2 - phi) * std::cos(phi + PI / 2);
+    const float v2fy = ((v2 * std::cos(theta2 - phi) * (m2 - m1) + 2 * m1 * v1 * std::cos(theta1 - phi)) / (m2 + m1))
+        * std::sin(phi) + v2 * std::sin(theta2 - phi) * std::sin(phi + PI / 2);
+
+    velocity1 = { v1fx, v1fy };
+    velocity2 = { v2fx, v2fy };
+}
+}
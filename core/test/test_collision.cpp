@@ -0,0 +1,52 @@
+#include "maths/collision.h"
+#include <gtest/gtest.h>
+
+#include "collision_reference.h"
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+void ExpectVec2Near(core::Vec2f value, core::Vec2f expected)
+{
+    constexpr float tolerance = 1e-4f;
+    EXPECT_NEAR(value.x, expected.x, tolerance * std::max(1.0f, std::abs(expected.x)));
+    EXPECT_NEAR(value.y, expected.y, tolerance * std::max(1.0f, std::abs(expected.y)));
+}
+}
+
+TEST(Collision, HeadOnEqualMasses)
+{
+    core::Vec2f velocity1{ 1.0f, 0.0f };
+    core::Vec2f velocity2{ -1.0f, 0.0f };
+    core::SolveElasticCollision(velocity1, 1.0f, velocity2, 1.0f, core::Vec2f::left());
+    ExpectVec2Near(velocity1, { -1.0f, 0.0f });
+    ExpectVec2Near(velocity2, { 1.0f, 0.0f });
+}
+
+TEST(Collision, ConformanceWithTrigonometric)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> velocityDistribution(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> massDistribution(0.1f, 10.0f);
+    for (int i = 0; i < 1000; i++)
+    {
+        const core::Vec2f velocity1{ velocityDistribution(generator), velocityDistribution(generator) };
+        const core::Vec2f velocity2 = i % 10 == 0 ? core::Vec2f::zero() :
+            core::Vec2f{ velocityDistribution(generator), velocityDistribution(generator) };
+        const core::Vec2f normal = core::Vec2f{ velocityDistribution(generator), velocityDistribution(generator) }.GetNormalized();
+        const float mass1 = massDistribution(generator);
+        const float mass2 = massDistribution(generator);
+
+        auto expected1 = velocity1;
+        auto expected2 = velocity2;
+        core::SolveElasticCollisionTrigonometric(expected1, mass1, expected2, mass2, normal);
+        auto result1 = velocity1;
+        auto result2 = velocity2;
+        core::SolveElasticCollision(result1, mass1, result2, mass2, normal);
+
+        ExpectVec2Near(result1, expected1);
+        ExpectVec2Near(result2, expected2);
+    }
+}
@@ -77,4 +77,71 @@ TEST(Component, InternalArrayOverflow)
     const auto entity = entityManager.CreateEntity();
     componentManager.AddComponent(entity);
     EXPECT_LT(core::entityInitNmb, componentManager.GetAllComponents().size());
-}
\ No newline at end of file
+}
+class SimpleSparseComponentManager : public core::SparseComponentManager<int, componentType>
+{
+    using SparseComponentManager::SparseComponentManager;
+};
+
+TEST(SparseComponent, AddRemoveComponent)
+{
+    constexpr int value1 = 45;
+    constexpr int value3 = 47;
+    core::EntityManager entityManager;
+    SimpleSparseComponentManager componentManager(entityManager);
+
+    const auto entity1 = entityManager.CreateEntity();
+    const auto entity2 = entityManager.CreateEntity();
+    const auto entity3 = entityManager.CreateEntity();
+    componentManager.AddComponent(entity1);
+    componentManager.SetComponent(entity1, value1);
+    componentManager.AddComponent(entity2);
+    componentManager.AddComponent(entity3);
+    componentManager.SetComponent(entity3, value3);
+    EXPECT_EQ(componentManager.GetSize(), 3);
+
+    componentManager.RemoveComponent(entity2);
+    EXPECT_FALSE(entityManager.HasComponent(entity2, componentType));
+    EXPECT_EQ(componentManager.GetSize(), 2);
+    EXPECT_EQ(componentManager.GetComponent(entity1), value1);
+    EXPECT_EQ(componentManager.GetComponent(entity3), value3);
+}
+
+TEST(SparseComponent, RemoveDestroyedEntities)
+{
+    core::EntityManager entityManager;
+    SimpleSparseComponentManager componentManager(entityManager);
+
+    const auto entity1 = entityManager.CreateEntity();
+    const auto entity2 = entityManager.CreateEntity();
+    componentManager.AddComponent(entity1);
+    componentManager.AddComponent(entity2);
+    entityManager.DestroyEntity(entity1);
+    componentManager.RemoveDestroyedEntities();
+    ASSERT_EQ(componentManager.GetSize(), 1);
+    EXPECT_EQ(componentManager.GetEntities()[0], entity2);
+}
+
+TEST(SparseComponent, CopyAllComponents)
+{
+    constexpr int oldValue1 = 45;
+    constexpr int newValue1 = 43;
+    constexpr int newValue2 = 47;
+    core::EntityManager entityManager;
+    SimpleSparseComponentManager oldComponentManager(entityManager);
+    SimpleSparseComponentManager newComponentManager(entityManager);
+
+    const auto entity1 = entityManager.CreateEntity();
+    const auto entity2 = entityManager.CreateEntity();
+    oldComponentManager.AddComponent(entity1);
+    oldComponentManager.SetComponent(entity1, oldValue1);
+    newComponentManager.AddComponent(entity2);
+    newComponentManager.SetComponent(entity2, newValue2);
+    newComponentManager.AddComponent(entity1);
+    newComponentManager.SetComponent(entity1, newValue1);
+
+    oldComponentManager.CopyAllComponents(newComponentManager.GetPackedComponents());
+    EXPECT_EQ(oldComponentManager.GetSize(), 2);
+    EXPECT_EQ(oldComponentManager.GetComponent(entity1), newValue1);
+    EXPECT_EQ(oldComponentManager.GetComponent(entity2), newValue2);
+}
@@ -43,4 +43,30 @@ TEST(Entity, EntityComponent)
     entityManager.DestroyEntity(newEntity);
     EXPECT_FALSE(entityManager.HasComponent(newEntity, newComponent));
     EXPECT_FALSE(entityManager.HasComponent(newEntity, newComponent2));
-}
\ No newline at end of file
+}
+TEST(Entity, RecycleEntity)
+{
+    core::EntityManager entityManager;
+    const auto entity1 = entityManager.CreateEntity();
+    const auto entity2 = entityManager.CreateEntity();
+    EXPECT_NE(entity1, entity2);
+
+    const auto generation = entityManager.GetGeneration(entity1);
+    entityManager.DestroyEntity(entity1);
+    const auto newEntity = entityManager.CreateEntity();
+    EXPECT_EQ(newEntity, entity1);
+    EXPECT_NE(entityManager.GetGeneration(newEntity), generation);
+    //The old handle is stale even if the index is alive again
+    EXPECT_FALSE(entityManager.IsEntityValid(entity1, generation));
+    EXPECT_TRUE(entityManager.IsEntityValid(newEntity, entityManager.GetGeneration(newEntity)));
+}
+
+TEST(Entity, EntityArrayOverflow)
+{
+    core::EntityManager entityManager(1);
+    for (core::Entity i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(entityManager.CreateEntity(), i);
+    }
+    EXPECT_LE(10, entityManager.GetEntitiesSize());
+}
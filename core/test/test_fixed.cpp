@@ -0,0 +1,125 @@
+#include "maths/fixed.h"
+#include "maths/fixed_vec2.h"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace
+{
+constexpr float TRIGONOMETRY_TOLERANCE = 1e-4f;
+constexpr float RESOLUTION = 1.0f / static_cast<float>(core::Fixed::ONE);
+}
+
+TEST(Fixed, FromFloat)
+{
+    constexpr core::Fixed value{ 1.5f };
+    constexpr core::Fixed negative{ -2.25f };
+    static_assert(value.raw() == 3 * core::Fixed::ONE / 2);
+
+    EXPECT_FLOAT_EQ(1.5f, value.ToFloat());
+    EXPECT_FLOAT_EQ(-2.25f, negative.ToFloat());
+    EXPECT_NEAR(0.1f, core::Fixed(0.1f).ToFloat(), RESOLUTION);
+}
+
+TEST(Fixed, Arithmetic)
+{
+    constexpr core::Fixed a{ 3.5f };
+    constexpr core::Fixed b{ -1.25f };
+
+    EXPECT_FLOAT_EQ(2.25f, (a + b).ToFloat());
+    EXPECT_FLOAT_EQ(4.75f, (a - b).ToFloat());
+    EXPECT_FLOAT_EQ(-4.375f, (a * b).ToFloat());
+    EXPECT_NEAR(-2.8f, (a / b).ToFloat(), RESOLUTION);
+    EXPECT_FLOAT_EQ(7.0f, (2 * a).ToFloat());
+    EXPECT_TRUE(b < a);
+    EXPECT_TRUE(a == core::Fixed(3.5f));
+}
+
+TEST(Fixed, OverflowWraps)
+{
+    constexpr auto max = core::Fixed::FromRaw(std::numeric_limits<core::Fixed::Raw>::max());
+    constexpr auto lowest = core::Fixed::FromRaw(std::numeric_limits<core::Fixed::Raw>::lowest());
+    constexpr auto epsilon = core::Fixed::FromRaw(1);
+
+    static_assert(max + epsilon == lowest);
+    static_assert(lowest - epsilon == max);
+    static_assert(-lowest == lowest);
+    auto sum = max;
+    sum += epsilon;
+    EXPECT_EQ(lowest, sum);
+
+    static_assert(core::Fixed(core::Fixed::MAX_INT).raw() == core::Fixed::MAX_INT * core::Fixed::ONE);
+    static_assert(core::Fixed(core::Fixed::MIN_INT).raw() == std::numeric_limits<core::Fixed::Raw>::lowest());
+    EXPECT_FLOAT_EQ(-7.0f, core::Fixed(-7).ToFloat());
+}
+
+TEST(Fixed, DivideByZero)
+{
+    const auto positive = core::Fixed(1) / core::Fixed();
+    const auto negative = core::Fixed(-1) / core::Fixed();
+
+    EXPECT_EQ(std::numeric_limits<core::Fixed::Raw>::max(), positive.raw());
+    EXPECT_EQ(std::numeric_limits<core::Fixed::Raw>::lowest(), negative.raw());
+}
+
+TEST(Fixed, Sqrt)
+{
+    EXPECT_FLOAT_EQ(2.0f, core::Sqrt(core::Fixed(4)).ToFloat());
+    EXPECT_FLOAT_EQ(0.0f, core::Sqrt(core::Fixed(-4)).ToFloat());
+    for (float value = 0.0f; value < 100.0f; value += 0.37f)
+    {
+        EXPECT_NEAR(std::sqrt(core::Fixed(value).ToFloat()), core::Sqrt(core::Fixed(value)).ToFloat(), RESOLUTION);
+    }
+}
+
+TEST(Fixed, SinCos)
+{
+    for (float degrees = -720.0f; degrees <= 720.0f; degrees += 7.5f)
+    {
+        const float radians = degrees / 180.0f * core::PI;
+        EXPECT_NEAR(std::sin(radians), core::Sin(core::Fixed(degrees)).ToFloat(), TRIGONOMETRY_TOLERANCE);
+        EXPECT_NEAR(std::cos(radians), core::Cos(core::Fixed(degrees)).ToFloat(), TRIGONOMETRY_TOLERANCE);
+    }
+}
+
+TEST(Fixed, Atan2)
+{
+    EXPECT_FLOAT_EQ(0.0f, core::Atan2(core::Fixed(), core::Fixed()).ToFloat());
+    for (float degrees = -175.0f; degrees <= 180.0f; degrees += 5.0f)
+    {
+        const float radians = degrees / 180.0f * core::PI;
+        const core::Fixed y{ 3.0f * std::sin(radians) };
+        const core::Fixed x{ 3.0f * std::cos(radians) };
+        EXPECT_NEAR(degrees, core::Atan2(y, x).ToFloat(), 0.01f);
+    }
+}
+
+TEST(Fixed, GetPosAngle)
+{
+    EXPECT_FLOAT_EQ(270.0f, core::GetPosAngle(core::Fixed(-90)).ToFloat());
+    EXPECT_FLOAT_EQ(30.0f, core::GetPosAngle(core::Fixed(750)).ToFloat());
+}
+
+TEST(FixedVec2, Magnitude)
+{
+    const core::FixedVec2 v{ 3, 4 };
+    EXPECT_FLOAT_EQ(5.0f, v.GetMagnitude().ToFloat());
+    EXPECT_FLOAT_EQ(25.0f, v.GetSqrMagnitude().ToFloat());
+
+    const auto normalized = v.GetNormalized();
+    EXPECT_NEAR(0.6f, normalized.x.ToFloat(), RESOLUTION);
+    EXPECT_NEAR(0.8f, normalized.y.ToFloat(), RESOLUTION);
+    EXPECT_TRUE(core::FixedVec2::zero().GetNormalized() == core::FixedVec2::zero());
+}
+
+TEST(FixedVec2, Rotate)
+{
+    const auto v = core::FixedVec2::up().Rotate(90);
+    EXPECT_NEAR(-1.0f, v.x.ToFloat(), TRIGONOMETRY_TOLERANCE);
+    EXPECT_NEAR(0.0f, v.y.ToFloat(), TRIGONOMETRY_TOLERANCE);
+
+    const core::Vec2f reference = core::Vec2f(1.2f, -0.7f).Rotate(core::Degree(33.0f));
+    const auto rotated = core::FixedVec2(core::Vec2f(1.2f, -0.7f)).Rotate(33).ToVec2f();
+    EXPECT_NEAR(reference.x, rotated.x, TRIGONOMETRY_TOLERANCE);
+    EXPECT_NEAR(reference.y, rotated.y, TRIGONOMETRY_TOLERANCE);
+}
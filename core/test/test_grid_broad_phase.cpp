@@ -0,0 +1,115 @@
+#include <engine/grid_broad_phase.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+struct TestCollider
+{
+    core::Entity entity = core::INVALID_ENTITY;
+    core::Vec2f position{};
+    float radius = 0.0f;
+};
+
+/**
+ * \brief CheckAgainstAllPairs checks that the grid finds every pair of touching colliders of an all-pairs loop,
+ * in the all-pairs order.
+ */
+void CheckAgainstAllPairs(const std::vector<TestCollider>& colliders, core::Vec2f areaSize)
+{
+    core::GridBroadPhase broadPhase(areaSize);
+    for (const auto& collider : colliders)
+    {
+        broadPhase.AddCollider(collider.entity, collider.position, collider.radius);
+    }
+    broadPhase.BuildPairs();
+    const auto& pairs = broadPhase.GetPairs();
+    EXPECT_TRUE(std::is_sorted(pairs.begin(), pairs.end()));
+    EXPECT_EQ(std::adjacent_find(pairs.begin(), pairs.end()), pairs.end());
+
+    std::size_t touchingNmb = 0;
+    for (std::size_t i = 0; i < colliders.size(); i++)
+    {
+        for (std::size_t j = i + 1; j < colliders.size(); j++)
+        {
+            const auto radii = colliders[i].radius + colliders[j].radius;
+            if ((colliders[i].position - colliders[j].position).GetSqrMagnitude() > radii * radii)
+            {
+                continue;
+            }
+            touchingNmb++;
+            EXPECT_TRUE(std::binary_search(pairs.begin(), pairs.end(), std::make_pair(colliders[i].entity, colliders[j].entity)))
+                << "Missing pair " << colliders[i].entity << " " << colliders[j].entity;
+        }
+    }
+    EXPECT_GT(touchingNmb, 0u);
+}
+}
+
+TEST(GridBroadPhase, RandomCollidersMatchAllPairs)
+{
+    const core::Vec2f areaSize(10.0f, 6.0f);
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> positionX(-6.0f, 6.0f);
+    std::uniform_real_distribution<float> positionY(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> radius(0.05f, 0.5f);
+    for (int test = 0; test < 20; test++)
+    {
+        //Some colliders are outside of the area, in the clamped border cells
+        std::vector<TestCollider> colliders(300);
+        for (core::Entity entity = 0; entity < colliders.size(); entity++)
+        {
+            colliders[entity] = { entity, core::Vec2f(positionX(generator), positionY(generator)), radius(generator) };
+        }
+        CheckAgainstAllPairs(colliders, areaSize);
+    }
+}
+
+TEST(GridBroadPhase, CollidersOnCellBorders)
+{
+    const core::Vec2f areaSize(6.0f, 6.0f);
+    constexpr float maxRadius = 0.5f;
+    //Cells are 1.5 wide from -3, colliders on the borders touch the ones of the next cells
+    constexpr float cellSize = 3.0f * maxRadius;
+    std::vector<TestCollider> colliders;
+    core::Entity entity = 0;
+    for (int y = 0; y <= 4; y++)
+    {
+        for (int x = 0; x <= 4; x++)
+        {
+            const core::Vec2f position(-3.0f + static_cast<float>(x) * cellSize, -3.0f + static_cast<float>(y) * cellSize);
+            colliders.push_back({ entity++, position, maxRadius });
+            //A small collider just across the border, and one a full cell away that still touches
+            colliders.push_back({ entity++, position + core::Vec2f(0.01f, 0.0f), 0.1f });
+            colliders.push_back({ entity++, position + core::Vec2f(0.0f, cellSize - 0.01f), maxRadius });
+        }
+    }
+    CheckAgainstAllPairs(colliders, areaSize);
+}
+
+TEST(GridBroadPhase, MarginAfterBuild)
+{
+    core::GridBroadPhase broadPhase(core::Vec2f(10.0f, 10.0f));
+    broadPhase.AddCollider(0, core::Vec2f(0.0f, 0.0f), 0.5f);
+    broadPhase.AddCollider(1, core::Vec2f(1.4f, 0.0f), 0.2f);
+    broadPhase.BuildPairs();
+    EXPECT_FLOAT_EQ(broadPhase.GetMargin(), 0.5f);
+    ASSERT_EQ(broadPhase.GetPairs().size(), 1u);
+
+    //Two colliders further than one cell away, that move together by less than the margin, are not touching
+    broadPhase.Clear();
+    broadPhase.AddCollider(0, core::Vec2f(0.0f, 0.0f), 0.5f);
+    broadPhase.AddCollider(1, core::Vec2f(3.1f, 0.0f), 0.5f);
+    broadPhase.BuildPairs();
+    EXPECT_TRUE(broadPhase.GetPairs().empty());
+    EXPECT_GT(3.1f - broadPhase.GetMargin(), 1.0f);
+
+    //A larger margin finds them
+    broadPhase.BuildPairs(2.0f);
+    EXPECT_FLOAT_EQ(broadPhase.GetMargin(), 2.0f);
+    EXPECT_EQ(broadPhase.GetPairs().size(), 1u);
+}
@@ -0,0 +1,52 @@
+#include "utils/hash.h"
+#include <gtest/gtest.h>
+
+#include <bit>
+
+namespace
+{
+std::uint64_t HashValues(std::uint32_t a, float b, bool c)
+{
+    core::Hash64 hash;
+    hash.Add(a);
+    hash.Add(b);
+    hash.Add(c);
+    return hash.GetDigest();
+}
+}
+
+TEST(Hash, SameValuesSameHash)
+{
+    EXPECT_EQ(HashValues(42u, 1.5f, true), HashValues(42u, 1.5f, true));
+    EXPECT_NE(HashValues(42u, 1.5f, true), HashValues(42u, 1.5f, false));
+    EXPECT_NE(core::Hash64().GetDigest(), core::Hash64(1u).GetDigest());
+}
+
+TEST(Hash, OrderMatters)
+{
+    core::Hash64 hash1;
+    hash1.Add(1u);
+    hash1.Add(2u);
+    core::Hash64 hash2;
+    hash2.Add(2u);
+    hash2.Add(1u);
+
+    EXPECT_NE(hash1.GetDigest(), hash2.GetDigest());
+}
+
+TEST(Hash, SignedZero)
+{
+    EXPECT_EQ(HashValues(0u, 0.0f, false), HashValues(0u, -0.0f, false));
+}
+
+TEST(Hash, Avalanche)
+{
+    //Flipping a single input bit should change about half of the output bits
+    const auto reference = HashValues(0u, 1.0f, false);
+    for (std::uint32_t bit = 0; bit < 32; bit++)
+    {
+        const auto changedBits = std::popcount(reference ^ HashValues(1u << bit, 1.0f, false));
+        EXPECT_GT(changedBits, 12);
+        EXPECT_LT(changedBits, 52);
+    }
+}
@@ -0,0 +1,56 @@
+#include "utils/spsc_ring.h"
+#include <gtest/gtest.h>
+
+#include <thread>
+
+TEST(SpscRing, FullAndEmpty)
+{
+    core::SpscRing<int, 4> ring;
+    int value = 0;
+    EXPECT_TRUE(ring.IsEmpty());
+    EXPECT_FALSE(ring.TryPop(value));
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(ring.TryPush(i));
+    }
+    EXPECT_FALSE(ring.TryPush(4));
+    EXPECT_TRUE(ring.TryPop(value));
+    EXPECT_EQ(0, value);
+    EXPECT_TRUE(ring.TryPush(4));
+    for (int i = 1; i <= 4; i++)
+    {
+        EXPECT_TRUE(ring.TryPop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(SpscRing, TwoThreadsKeepOrder)
+{
+    constexpr int valueNmb = 100'000;
+    core::SpscRing<int, 64> ring;
+    std::thread producer([&ring]
+    {
+        for (int i = 0; i < valueNmb; i++)
+        {
+            while (!ring.TryPush(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int expectedValue = 0;
+    while (expectedValue < valueNmb)
+    {
+        int value = 0;
+        if (!ring.TryPop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(expectedValue, value);
+        expectedValue++;
+    }
+    producer.join();
+    EXPECT_TRUE(ring.IsEmpty());
+}
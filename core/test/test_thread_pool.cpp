@@ -0,0 +1,27 @@
+#include "utils/thread_pool.h"
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+TEST(ThreadPool, EachIndexOnce)
+{
+    core::ThreadPool threadPool(3);
+    std::vector<std::atomic<int>> calls(1000);
+    for (int batch = 0; batch < 10; batch++)
+    {
+        threadPool.ParallelFor(calls.size(), [&calls](std::size_t i) { calls[i]++; });
+    }
+    for (const auto& call : calls)
+    {
+        EXPECT_EQ(10, call.load());
+    }
+}
+
+TEST(ThreadPool, NoWorker)
+{
+    core::ThreadPool threadPool(0);
+    std::vector<std::size_t> values(16);
+    threadPool.ParallelFor(values.size(), [&values](std::size_t i) { values[i] = i; });
+    EXPECT_EQ(120u, std::accumulate(values.begin(), values.end(), std::size_t{ 0 }));
+    EXPECT_EQ(0u, threadPool.GetWorkerNmb());
+}
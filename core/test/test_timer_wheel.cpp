@@ -0,0 +1,59 @@
+#include "utils/timer_wheel.h"
+#include <gtest/gtest.h>
+
+TEST(TimerWheel, OneShot)
+{
+    core::TimerWheel timerWheel(sf::milliseconds(1), 16);
+    int calls = 0;
+    timerWheel.Schedule(sf::milliseconds(5), [&calls] { calls++; });
+    EXPECT_EQ(5000, timerWheel.GetTimeUntilNextTimer().asMicroseconds());
+
+    timerWheel.Advance(sf::milliseconds(4));
+    EXPECT_EQ(0, calls);
+    timerWheel.Advance(sf::milliseconds(1));
+    EXPECT_EQ(1, calls);
+    timerWheel.Advance(sf::milliseconds(100));
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(0u, timerWheel.GetTimerNmb());
+    EXPECT_LT(timerWheel.GetTimeUntilNextTimer().asMicroseconds(), 0);
+}
+
+TEST(TimerWheel, MoreThanOneRevolution)
+{
+    core::TimerWheel timerWheel(sf::milliseconds(1), 8);
+    int calls = 0;
+    timerWheel.Schedule(sf::milliseconds(20), [&calls] { calls++; });
+    EXPECT_EQ(20000, timerWheel.GetTimeUntilNextTimer().asMicroseconds());
+    timerWheel.Advance(sf::milliseconds(19));
+    EXPECT_EQ(0, calls);
+    timerWheel.Advance(sf::milliseconds(1));
+    EXPECT_EQ(1, calls);
+}
+
+TEST(TimerWheel, PeriodicAndCancel)
+{
+    core::TimerWheel timerWheel(sf::milliseconds(2), 16);
+    int calls = 0;
+    const auto timerId = timerWheel.Schedule(sf::milliseconds(20), [&calls] { calls++; }, sf::milliseconds(20));
+    for (int i = 0; i < 100; i++)
+    {
+        timerWheel.Advance(sf::milliseconds(1));
+    }
+    EXPECT_EQ(5, calls);
+    timerWheel.Cancel(timerId);
+    timerWheel.Advance(sf::milliseconds(100));
+    EXPECT_EQ(5, calls);
+}
+
+TEST(TimerWheel, ScheduleFromCallback)
+{
+    core::TimerWheel timerWheel(sf::milliseconds(1));
+    std::vector<int> order;
+    timerWheel.Schedule(sf::milliseconds(1), [&timerWheel, &order]
+        {
+            order.push_back(1);
+            timerWheel.Schedule(sf::milliseconds(1), [&order] { order.push_back(2); });
+        });
+    timerWheel.Advance(sf::milliseconds(3));
+    EXPECT_EQ((std::vector<int>{1, 2}), order);
+}
@@ -0,0 +1,91 @@
+#include <engine/entity.h>
+#include <engine/view.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "engine/component.h"
+
+constexpr core::EntityMask viewComponentType = 2u;
+constexpr core::EntityMask viewOtherComponentType = 4u;
+constexpr core::EntityMask viewExcludedType = 8u;
+
+class ViewComponentManager : public core::ComponentManager<int, viewComponentType>
+{
+    using ComponentManager::ComponentManager;
+};
+
+class ViewSparseComponentManager : public core::SparseComponentManager<float, viewOtherComponentType>
+{
+    using SparseComponentManager::SparseComponentManager;
+};
+
+TEST(View, IterateMatchingEntities)
+{
+    core::EntityManager entityManager;
+    ViewComponentManager componentManager(entityManager);
+    ViewSparseComponentManager otherComponentManager(entityManager);
+
+    std::vector<core::Entity> expectedEntities;
+    //Cover several words of the component bits
+    for (core::Entity i = 0; i < 300; i++)
+    {
+        const auto entity = entityManager.CreateEntity();
+        if (i % 3 == 0)
+        {
+            componentManager.AddComponent(entity);
+            componentManager.SetComponent(entity, static_cast<int>(entity));
+        }
+        if (i % 5 == 0)
+        {
+            otherComponentManager.AddComponent(entity);
+        }
+        if (i % 3 == 0 && i % 5 == 0)
+        {
+            expectedEntities.push_back(entity);
+        }
+    }
+
+    std::vector<core::Entity> entities;
+    for (auto [entity, value, otherValue] : core::View(entityManager, componentManager, otherComponentManager))
+    {
+        EXPECT_EQ(value, static_cast<int>(entity));
+        otherValue = 1.0f;
+        entities.push_back(entity);
+    }
+    EXPECT_EQ(entities, expectedEntities);
+    EXPECT_EQ(otherComponentManager.GetComponent(expectedEntities.back()), 1.0f);
+}
+
+TEST(View, ExcludeMask)
+{
+    core::EntityManager entityManager;
+    ViewComponentManager componentManager(entityManager);
+
+    const auto entity1 = entityManager.CreateEntity();
+    const auto entity2 = entityManager.CreateEntity();
+    const auto entity3 = entityManager.CreateEntity();
+    componentManager.AddComponent(entity1);
+    componentManager.AddComponent(entity2);
+    componentManager.AddComponent(entity3);
+    entityManager.AddComponent(entity2, viewExcludedType);
+    entityManager.DestroyEntity(entity3);
+
+    std::vector<core::Entity> entities;
+    for (auto [entity, value] : core::View(entityManager, componentManager).Exclude(viewExcludedType))
+    {
+        entities.push_back(entity);
+    }
+    ASSERT_EQ(entities.size(), 1);
+    EXPECT_EQ(entities[0], entity1);
+}
+
+TEST(View, EmptyView)
+{
+    core::EntityManager entityManager;
+    ViewComponentManager componentManager(entityManager);
+    entityManager.CreateEntity();
+
+    const auto view = core::View(entityManager, componentManager);
+    EXPECT_TRUE(view.begin() == view.end());
+}
@@ -0,0 +1,292 @@
+#include "network/simulation_client.h"
+#include "network/simulation_server.h"
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct BenchOptions
+{
+    game::PlayerNumber playerNmb = game::DEFAULT_PLAYER_NMB;
+    game::Frame frameNmb = 3000;
+    //In seconds
+    float rtt = 0.1f;
+    float jitter = 0.01f;
+    float packetLoss = 0.0f;
+    unsigned seed = 42;
+    std::string inputScriptPath;
+};
+
+/**
+ * \brief InputScript gives the input of each player at each frame.
+ * The inputs are read from a text file with one line per frame and one input per player,
+ * looping at the end of the file, or drawn at random when there is no file.
+ */
+class InputScript
+{
+public:
+    explicit InputScript(unsigned seed) : generator_(seed) {}
+
+    bool Load(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+            std::istringstream lineStream(line);
+            std::array<game::PlayerInput, game::MAX_PLAYER_NMB> frameInputs{};
+            unsigned input = 0;
+            for (std::size_t playerNumber = 0; playerNumber < frameInputs.size() && lineStream >> input; playerNumber++)
+            {
+                frameInputs[playerNumber] = static_cast<game::PlayerInput>(input);
+            }
+            frames_.push_back(frameInputs);
+        }
+        return !frames_.empty();
+    }
+
+    [[nodiscard]] game::PlayerInput GetInput(game::PlayerNumber playerNumber, game::Frame frame)
+    {
+        if (!frames_.empty())
+        {
+            return frames_[frame % frames_.size()][playerNumber];
+        }
+        //Players keep an input for a few frames, like on a keyboard
+        if (generator_() % 15 == 0)
+        {
+            using namespace game::PlayerInputEnum;
+            static constexpr std::array<game::PlayerInput, 8> randomInputs
+            {
+                NONE, UP, DOWN, LEFT, RIGHT, static_cast<game::PlayerInput>(UP | LEFT), PUNCH, PUNCH2
+            };
+            randomInputs_[playerNumber] = randomInputs[generator_() % randomInputs.size()];
+        }
+        return randomInputs_[playerNumber];
+    }
+private:
+    std::vector<std::array<game::PlayerInput, game::MAX_PLAYER_NMB>> frames_;
+    std::array<game::PlayerInput, game::MAX_PLAYER_NMB> randomInputs_{};
+    std::mt19937 generator_;
+};
+
+void PrintUsage()
+{
+    fmt::print("Usage: rollback_bench [--players N] [--frames N] [--rtt ms] [--jitter ms] [--loss percent] "
+        "[--seed N] [--inputs file]\n");
+}
+
+bool ParseOptions(int argc, char** argv, BenchOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view option = argv[i];
+        if (i + 1 == argc)
+        {
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (option == "--players")
+        {
+            options.playerNmb = static_cast<game::PlayerNumber>(std::stoul(value));
+            if (options.playerNmb == 0 || options.playerNmb > game::MAX_PLAYER_NMB)
+            {
+                return false;
+            }
+        }
+        else if (option == "--frames")
+        {
+            options.frameNmb = static_cast<game::Frame>(std::stoul(value));
+        }
+        else if (option == "--rtt")
+        {
+            options.rtt = std::stof(value) / 1000.0f;
+        }
+        else if (option == "--jitter")
+        {
+            options.jitter = std::stof(value) / 1000.0f;
+        }
+        else if (option == "--loss")
+        {
+            options.packetLoss = std::stof(value) / 100.0f;
+        }
+        else if (option == "--seed")
+        {
+            options.seed = static_cast<unsigned>(std::stoul(value));
+        }
+        else if (option == "--inputs")
+        {
+            options.inputScriptPath = value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+double GetPercentile(std::vector<std::chrono::nanoseconds>& durations, double percentile)
+{
+    if (durations.empty())
+    {
+        return 0.0;
+    }
+    const auto index = static_cast<std::size_t>(percentile * static_cast<double>(durations.size() - 1));
+    std::nth_element(durations.begin(), durations.begin() + static_cast<std::ptrdiff_t>(index), durations.end());
+    return std::chrono::duration<double, std::micro>(durations[index]).count();
+}
+}
+
+/**
+ * \brief rollback_bench plays a game between SimulationClient without window, through a SimulationServer
+ * with the given round trip time, jitter and packet loss, and reports the rollback cost.
+ */
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    try
+    {
+        if (!ParseOptions(argc, argv, options))
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+    catch (const std::exception&)
+    {
+        PrintUsage();
+        return 1;
+    }
+    InputScript inputScript(options.seed);
+    if (!options.inputScriptPath.empty() && !inputScript.Load(options.inputScriptPath))
+    {
+        fmt::print("Could not read input script: {}\n", options.inputScriptPath);
+        return 1;
+    }
+    spdlog::set_level(spdlog::level::warn);
+
+    std::vector<std::unique_ptr<game::SimulationClient>> clients(options.playerNmb);
+    game::SimulationServer server(clients);
+    for (auto& client : clients)
+    {
+        client = std::make_unique<game::SimulationClient>(server);
+    }
+    server.SetDelay(options.rtt / 2.0f, options.jitter);
+    server.SetPacketLoss(options.packetLoss);
+    for (const auto& client : clients)
+    {
+        client->Join();
+    }
+
+    const auto dt = sf::seconds(game::FIXED_PERIOD);
+    const auto isPlaying = [](const game::SimulationClient& client)
+    {
+        const auto state = client.GetGameManager().GetState();
+        return (state & game::ClientGameManager::STARTED) && !(state & game::ClientGameManager::FINISHED);
+    };
+    //The game starts START_DELAY after the start packet in real time, so the warm up is not sped up
+    const auto warmUpEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(2 * game::START_DELAY);
+    while (!std::all_of(clients.begin(), clients.end(), [&isPlaying](const auto& client) { return isPlaying(*client); }))
+    {
+        if (std::chrono::steady_clock::now() > warmUpEnd)
+        {
+            fmt::print("The game did not start\n");
+            return 1;
+        }
+        server.Update(dt);
+        for (const auto& client : clients)
+        {
+            client->Update(dt);
+        }
+        std::this_thread::sleep_for(std::chrono::duration<float>(game::FIXED_PERIOD));
+    }
+
+    std::vector<game::Frame> startFrames;
+    std::vector<std::uint64_t> startSimulatedFrames;
+    for (const auto& client : clients)
+    {
+        const auto& gameManager = client->GetGameManager();
+        startFrames.push_back(gameManager.GetCurrentFrame());
+        startSimulatedFrames.push_back(gameManager.GetRollbackManager().GetSimulatedFrameNmb());
+    }
+    std::vector<std::chrono::nanoseconds> simulateDurations;
+    simulateDurations.reserve(static_cast<std::size_t>(options.frameNmb) * clients.size());
+
+    const auto benchStart = std::chrono::steady_clock::now();
+    game::Frame frameNmb = 0;
+    for (; frameNmb < options.frameNmb; frameNmb++)
+    {
+        if (!std::all_of(clients.begin(), clients.end(), [&isPlaying](const auto& client) { return isPlaying(*client); }))
+        {
+            break;
+        }
+        for (const auto& client : clients)
+        {
+            const auto& gameManager = client->GetGameManager();
+            client->SetPlayerInput(inputScript.GetInput(gameManager.GetPlayerNumber(), gameManager.GetCurrentFrame()));
+        }
+        server.Update(dt);
+        for (const auto& client : clients)
+        {
+            //ClientGameManager::Update simulates to the current frame while the game is playing
+            const bool simulates = isPlaying(*client);
+            client->Update(dt);
+            if (simulates)
+            {
+                simulateDurations.push_back(client->GetGameManager().GetRollbackManager().GetLastSimulateDuration());
+            }
+        }
+    }
+    const std::chrono::duration<double> benchDuration = std::chrono::steady_clock::now() - benchStart;
+
+    std::uint64_t displayedFrameNmb = 0;
+    std::uint64_t simulatedFrameNmb = 0;
+    for (std::size_t i = 0; i < clients.size(); i++)
+    {
+        const auto& gameManager = clients[i]->GetGameManager();
+        displayedFrameNmb += gameManager.GetCurrentFrame() - startFrames[i];
+        simulatedFrameNmb += gameManager.GetRollbackManager().GetSimulatedFrameNmb() - startSimulatedFrames[i];
+    }
+    std::chrono::duration<double> simulateDuration{};
+    for (const auto duration : simulateDurations)
+    {
+        simulateDuration += duration;
+    }
+
+    fmt::print("players: {}, rtt: {:.0f} ms, jitter: {:.0f} ms, loss: {:.1f}%, inputs: {}\n",
+        options.playerNmb, options.rtt * 1000.0f, options.jitter * 1000.0f, options.packetLoss * 100.0f,
+        options.inputScriptPath.empty() ? fmt::format("random (seed {})", options.seed) : options.inputScriptPath);
+    if (frameNmb < options.frameNmb)
+    {
+        fmt::print("The game finished after {} frames\n", frameNmb);
+    }
+    fmt::print("frames: {} in {:.3f} s, {:.0f} frames/s for the server and the {} clients\n",
+        frameNmb, benchDuration.count(), frameNmb / benchDuration.count(), clients.size());
+    fmt::print("simulated frames: {}, {:.0f} frames/s in SimulateToCurrentFrame\n",
+        simulatedFrameNmb, simulateDuration.count() > 0.0 ? simulatedFrameNmb / simulateDuration.count() : 0.0);
+    fmt::print("re-simulated frames per displayed frame: {:.2f}\n",
+        displayedFrameNmb > 0 ? static_cast<double>(simulatedFrameNmb - std::min(simulatedFrameNmb, displayedFrameNmb)) / displayedFrameNmb : 0.0);
+    fmt::print("SimulateToCurrentFrame latency: p50 {:.1f} us, p99 {:.1f} us\n",
+        GetPercentile(simulateDurations, 0.5), GetPercentile(simulateDurations, 0.99));
+    return 0;
+}
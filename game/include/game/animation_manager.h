@@ -29,9 +29,9 @@ struct AnimationData
 };
 
 /**
- * \brief AnimationManager is a ComponentManager that holds all the animations in one place.
+ * \brief AnimationManager is a SparseComponentManager that holds all the animations in one place.
  */
-class AnimationManager final : public core::ComponentManager<AnimationData, static_cast<core::EntityMask>(ComponentType::ANIMATION_DATA)>
+class AnimationManager final : public core::SparseComponentManager<AnimationData, static_cast<core::EntityMask>(ComponentType::ANIMATION_DATA)>
 {
 public:
     explicit AnimationManager(core::EntityManager& entityManager, core::SpriteManager& spriteManager);
@@ -21,7 +21,7 @@ struct Effect
 
 class GameManager;
 
-class EffectManager : public core::ComponentManager<Effect, static_cast<core::EntityMask>(ComponentType::EFFECT)>
+class EffectManager : public core::SparseComponentManager<Effect, static_cast<core::EntityMask>(ComponentType::EFFECT)>
 {
 public:
 	explicit EffectManager(core::EntityManager&, GameManager&);
@@ -9,6 +9,7 @@
 #include "engine/entity.h"
 #include "graphics/color.h"
 #include "maths/angle.h"
+#include "maths/fixed_vec2.h"
 #include "maths/vec2.h"
 
 
@@ -23,13 +24,76 @@ using PlayerNumber = std::uint8_t;
  * \brief INVALID_PLAYER is an integer constant that defines an invalid player number.
  */
 constexpr auto INVALID_PLAYER = std::numeric_limits<PlayerNumber>::max();
+/**
+ * \brief DRAW_PLAYER is the winner of a game that ends without one, when the last players left the stage at the same frame.
+ */
+constexpr PlayerNumber DRAW_PLAYER = INVALID_PLAYER - 1;
 /**
  * \brief ClientId is a type used to define the client identification.
  * It is given by the server to clients.
  */
 enum class ClientId : std::uint16_t {};
 constexpr auto INVALID_CLIENT_ID = ClientId{ 0 };
+/**
+ * \brief MatchId is a type used to identify a game among the ones hosted by a MatchServer.
+ */
+using MatchId = std::uint32_t;
+constexpr auto INVALID_MATCH_ID = std::numeric_limits<MatchId>::max();
 using Frame = std::uint32_t;
+/**
+ * \brief INVALID_FRAME is a constant that defines an invalid or not yet known frame.
+ */
+constexpr auto INVALID_FRAME = std::numeric_limits<Frame>::max();
+/**
+ * \brief Scalar is the number type of the simulation (Body, player and glove logic).
+ * It is a float, or with ENABLE_FIXED_POINT a Q16.16 fixed point number, so the server and the clients simulate bit-identically.
+ */
+#ifdef ENABLE_FIXED_POINT
+using Scalar = core::Fixed;
+#else
+using Scalar = float;
+#endif
+/**
+ * \brief Vec2 is the vector type of the simulation, made of two Scalar.
+ */
+#ifdef ENABLE_FIXED_POINT
+using Vec2 = core::FixedVec2;
+#else
+using Vec2 = core::Vec2f;
+#endif
+/**
+ * \brief Angle is the angle type of the simulation, in degrees.
+ * It is a core::Degree, or with ENABLE_FIXED_POINT a fixed point number of degrees.
+ */
+#ifdef ENABLE_FIXED_POINT
+using Angle = core::Fixed;
+#else
+using Angle = core::Degree;
+#endif
+
+#ifdef ENABLE_FIXED_POINT
+constexpr Vec2 ToVec2(const core::Vec2f v) { return Vec2(v); }
+constexpr core::Vec2f ToVec2f(const Vec2 v) { return v.ToVec2f(); }
+constexpr Angle ToAngle(const core::Degree angle) { return angle.value(); }
+constexpr core::Degree ToDegree(const Angle angle) { return angle.ToFloat(); }
+constexpr float ToFloat(const Scalar value) { return value.ToFloat(); }
+constexpr Scalar GetDegrees(const Angle angle) { return angle; }
+#else
+constexpr Vec2 ToVec2(const core::Vec2f v) { return v; }
+constexpr core::Vec2f ToVec2f(const Vec2 v) { return v; }
+constexpr Angle ToAngle(const core::Degree angle) { return angle; }
+constexpr core::Degree ToDegree(const Angle angle) { return angle; }
+constexpr float ToFloat(const Scalar value) { return value; }
+constexpr Scalar GetDegrees(const Angle angle) { return angle.value(); }
+#endif
+/**
+ * \brief GetPosAngleBetween returns the angle to rotate from to get to, between 0 and 360 degrees.
+ */
+inline Angle GetPosAngleBetween(const Vec2 from, const Vec2 to)
+{
+    return core::GetPosAngle(core::Atan2(to.y, to.x) - core::Atan2(from.y, from.x));
+}
+
 /**
  * \brief mmaxPlayerNmb is a integer constant that defines the maximum number of player per game
  */
@@ -38,7 +102,16 @@ constexpr int ANIMATION_PIXEL_SIZE = 32;
 constexpr float EFFECTS_LIFETIME = 1.0f;
 constexpr float END_EFFECTS_LIFETIME = 150.0f;
 
-constexpr std::uint32_t MAX_PLAYER_NMB = 2;
+/**
+ * \brief MAX_PLAYER_NMB is the maximum number of players of a game, the per player arrays are sized with it.
+ * The number of players of a game is chosen at runtime, and the per player loops only go up to it.
+ */
+constexpr std::uint32_t MAX_PLAYER_NMB = 8;
+/**
+ * \brief DEFAULT_PLAYER_NMB is the number of players of a game when the server does not choose another one.
+ * It is also the number of local players of the debug apps, that share one keyboard.
+ */
+constexpr std::uint32_t DEFAULT_PLAYER_NMB = 2;
 constexpr float PLAYER_SPEED = 10.5f;
 constexpr float PLAYER_MAX_SPEED = 4.5f;
 constexpr float PLAYER_FRICTION_LOSS = 3.5f;
@@ -93,28 +166,43 @@ constexpr std::size_t MAX_INPUT_NMB = 50;
 constexpr float FIXED_PERIOD = 0.02f; //50fps
 
 constexpr core::Color GLOVE_OFF_COLOR(0,0,0, 155);
-constexpr std::array<core::Color, std::max(4u, MAX_PLAYER_NMB)> PLAYER_COLORS
+constexpr std::array<core::Color, MAX_PLAYER_NMB> PLAYER_COLORS
 {
     core::Color::red(),
     core::Color::blue(),
     core::Color::yellow(),
-    core::Color::cyan()
+    core::Color::cyan(),
+    core::Color::green(),
+    core::Color::magenta(),
+    core::Color(255, 128, 0),
+    core::Color::white()
 };
 
-constexpr std::array<core::Vec2f, std::max(4u, MAX_PLAYER_NMB)> SPAWN_POSITIONS
+/**
+ * \brief SPAWN_POSITIONS are on a circle around the center, the first players face each other.
+ */
+constexpr std::array<core::Vec2f, MAX_PLAYER_NMB> SPAWN_POSITIONS
 {
     core::Vec2f(0,-1),
     core::Vec2f(0,1),
     core::Vec2f(-1,0),
     core::Vec2f(1,0),
+    core::Vec2f(-0.7071f,-0.7071f),
+    core::Vec2f(0.7071f,0.7071f),
+    core::Vec2f(0.7071f,-0.7071f),
+    core::Vec2f(-0.7071f,0.7071f),
 };
 
-constexpr std::array<core::Degree, std::max(4u, MAX_PLAYER_NMB)> SPAWN_ROTATIONS
+constexpr std::array<core::Degree, MAX_PLAYER_NMB> SPAWN_ROTATIONS
 {
     core::Degree(0.0f),
     core::Degree(180.0f),
     core::Degree(-90.0f),
-    core::Degree(90.0f)
+    core::Degree(90.0f),
+    core::Degree(-45.0f),
+    core::Degree(135.0f),
+    core::Degree(45.0f),
+    core::Degree(-135.0f)
 };
 
 enum class ComponentType : core::EntityMask
@@ -1,23 +1,27 @@
 #pragma once
-#include <SFML/Graphics/Texture.hpp>
-#include <SFML/Graphics/Font.hpp>
-#include <SFML/Graphics/View.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Vector2.hpp>
-#include <SFML/Graphics/Text.hpp>
 
 #include "game_globals.h"
 #include "rollback_manager.h"
-#include "animation_manager.h"
 #include "effects.h"
 #include "engine/entity.h"
+#include "engine/system.h"
+#include "engine/transform.h"
+#include "network/packet_type.h"
+
+#ifndef GAME_HEADLESS
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/Graphics/Text.hpp>
+
+#include "animation_manager.h"
 #include "graphics/graphics.h"
 #include "graphics/sprite.h"
 #include "game/background.h"
 #include "game/sound.h"
-#include "engine/system.h"
-#include "engine/transform.h"
-#include "network/packet_type.h"
+#endif
 
 namespace game
 {
@@ -41,13 +45,26 @@ public:
     [[nodiscard]] Frame GetLastValidateFrame() const { return rollbackManager_.GetLastValidateFrame(); }
     [[nodiscard]] const core::TransformManager& GetTransformManager() const { return transformManager_; }
     [[nodiscard]] const RollbackManager& GetRollbackManager() const { return rollbackManager_; }
+    /**
+     * \brief SetPlayerNmb is a method that sets the number of players of the game, before it starts.
+     */
+    void SetPlayerNmb(PlayerNumber playerNmb);
+    [[nodiscard]] PlayerNumber GetPlayerNmb() const { return playerNmb_; }
     virtual void SetPlayerInput(PlayerNumber playerNumber, PlayerInput playerInput, std::uint32_t inputFrame);
     /**
      * \brief Validate is a method called by the server to validate a frame.
      */
     void Validate(Frame newValidateFrame);
+    /**
+     * \brief CheckWinner is a method that returns the last player inside the stage, DRAW_PLAYER when nobody is left,
+     * and INVALID_PLAYER while the game goes on.
+     */
     [[nodiscard]] PlayerNumber CheckWinner();
     virtual void WinGame(PlayerNumber winner);
+    /**
+     * \brief GetWinner is a method that returns the winner given to WinGame, INVALID_PLAYER while the game goes on.
+     */
+    [[nodiscard]] PlayerNumber GetWinner() const { return winner_; }
 
 protected:
     core::EntityManager entityManager_;
@@ -56,9 +73,11 @@ protected:
     std::array<core::Entity, MAX_PLAYER_NMB> playerEntityMap_{};
     std::array<core::Entity, 2 * MAX_PLAYER_NMB> gloveEntityMap_{};
     Frame currentFrame_ = 0;
+    PlayerNumber playerNmb_ = DEFAULT_PLAYER_NMB;
     PlayerNumber winner_ = INVALID_PLAYER;
 };
 
+#ifndef GAME_HEADLESS
 /**
  * \brief ClientGameManager is a class that inherits from GameManager by adding the visual part and specific implementations needed by the clients.
  */
@@ -92,7 +111,12 @@ public:
     void FixedUpdate();
     void SetPlayerInput(PlayerNumber playerNumber, PlayerInput playerInput, std::uint32_t inputFrame) override;
     void DrawImGui() override;
-    void ConfirmValidateFrame(Frame newValidateFrame, const std::array<PhysicsState, MAX_PLAYER_NMB>& physicsStates);
+    void ConfirmValidateFrame(Frame newValidateFrame, PhysicsState physicsState);
+    /**
+     * \brief AcknowledgeInputs is a method called when the server tells it is missing the local player inputs from inputAckFrame.
+     * The following input packets only contain the frames from inputAckFrame.
+     */
+    void AcknowledgeInputs(Frame inputAckFrame);
     [[nodiscard]] PlayerNumber GetPlayerNumber() const { return clientPlayer_; }
     void WinGame(PlayerNumber winner) override;
     [[nodiscard]] std::uint32_t GetState() const { return state_; }
@@ -112,6 +136,7 @@ protected:
     SoundPlayer soundPlayer_;
 
     float fixedTimer_ = 0.0f;
+    Frame inputAckFrame_ = 0;
     unsigned long long startingTime_ = 0;
     std::uint32_t state_ = 0;
 
@@ -124,4 +149,5 @@ protected:
     sf::Text textRenderer_;
     bool drawPhysics_ = false;
 };
+#endif
 }
@@ -21,9 +21,9 @@ struct Glove
     bool isRecovering = false;
     bool hasLaunched = false;
 
-    core::Vec2f velFromPlayer = core::Vec2f::zero();
+    Vec2 velFromPlayer = Vec2::zero();
     // The position the glove is returning from (i.e where the glove ended up after a punch)
-    core::Vec2f returningFromPos = core::Vec2f::zero();
+    Vec2 returningFromPos = Vec2::zero();
 };
 
 class GameManager;
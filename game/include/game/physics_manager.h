@@ -2,12 +2,15 @@
 #include "game_globals.h"
 #include "engine/component.h"
 #include "engine/entity.h"
+#include "engine/grid_broad_phase.h"
 #include "maths/angle.h"
 #include "maths/vec2.h"
 
 #include <SFML/System/Time.hpp>
 
+#ifndef GAME_HEADLESS
 #include "graphics/graphics.h"
+#endif
 #include "utils/action_utility.h"
 
 namespace core
@@ -28,11 +31,11 @@ enum class BodyType
  */
 struct Body
 {
-	float mass = 1.0f;
-	core::Vec2f position = core::Vec2f::zero();
-	core::Vec2f velocity = core::Vec2f::zero();
-	core::Degree angularVelocity = core::Degree(0.0f);
-	core::Degree rotation = core::Degree(0.0f);
+	Scalar mass = 1.0f;
+	Vec2 position = Vec2::zero();
+	Vec2 velocity = Vec2::zero();
+	Angle angularVelocity = Angle(0.0f);
+	Angle rotation = Angle(0.0f);
 	BodyType bodyType = BodyType::DYNAMIC;
 };
 
@@ -43,10 +46,10 @@ struct Circle
 {
 	constexpr Circle() = default;
 
-	explicit constexpr Circle(const float radius)
+	explicit constexpr Circle(const Scalar radius)
 		: radius(radius) {}
 
-	float radius = 0.0f;
+	Scalar radius = 0.0f;
 	bool isTrigger = false;
 	bool enabled = true;
 };
@@ -63,28 +66,36 @@ public:
 };
 
 /**
- * \brief BodyManager is a ComponentManager that holds all the Body in the world.
+ * \brief BodyManager is a SparseComponentManager that holds all the Body in the world.
  */
-class BodyManager : public core::ComponentManager<Body, static_cast<core::EntityMask>(core::ComponentType::BODY2D)>
+class BodyManager : public core::SparseComponentManager<Body, static_cast<core::EntityMask>(core::ComponentType::BODY2D)>
 {
 public:
-	using ComponentManager::ComponentManager;
+	using SparseComponentManager::SparseComponentManager;
+	/**
+	 * \brief ApplyVelocities is a method that moves the bodies by their velocities, walking the dense array.
+	 */
+	void ApplyVelocities(sf::Time dt);
 };
 
 /**
- * \brief colManager is a ComponentManager that holds all the col in the world.
+ * \brief colManager is a SparseComponentManager that holds all the col in the world.
  */
-class CircleManager : public core::ComponentManager<Circle, static_cast<core::EntityMask>(core::ComponentType::CIRCLE_COLLIDER2D)>
+class CircleManager : public core::SparseComponentManager<Circle, static_cast<core::EntityMask>(core::ComponentType::CIRCLE_COLLIDER2D)>
 {
 public:
-	using ComponentManager::ComponentManager;
+	using SparseComponentManager::SparseComponentManager;
 };
 
 /**
  * \brief PhysicsManager is a class that holds both BodyManager and colManager and manages the physics fixed update.
  * It allows to register OnTriggerInterface to be called when a trigger occcurs.
+ * The debug drawing of the colliders is compiled out of the headless server (GAME_HEADLESS).
  */
-class PhysicsManager : public core::DrawInterface
+class PhysicsManager
+#ifndef GAME_HEADLESS
+	: public core::DrawInterface
+#endif
 {
 public:
 	explicit PhysicsManager(core::EntityManager& entityManager);
@@ -102,17 +113,44 @@ public:
 	 */
 	void RegisterTriggerListener(OnTriggerInterface& onTriggerInterface);
 	void CopyAllComponents(const PhysicsManager& physicsManager);
+	/**
+	 * \brief CopyAllComponents is a method that replaces the bodies and colliders by the given live components.
+	 * It is used by the RollbackManager when restoring a frame snapshot.
+	 */
+	void CopyAllComponents(const core::PackedComponents<Body>& bodies, const core::PackedComponents<Circle>& cols);
+	[[nodiscard]] const core::PackedComponents<Body>& GetAllBodies() const { return bodyManager_.GetPackedComponents(); }
+	[[nodiscard]] const core::PackedComponents<Circle>& GetAllCols() const { return colManager_.GetPackedComponents(); }
+#ifndef GAME_HEADLESS
 	void Draw(sf::RenderTarget& renderTarget) override;
 	void SetCenter(sf::Vector2f center) { center_ = center; }
 	void SetWindowSize(sf::Vector2f newWindowSize) { windowSize_ = newWindowSize; }
+#endif
 private:
+	/**
+	 * \brief BuildCollisionPairs is a method that fills the broad phase with the pairs of colliders in neighbouring cells
+	 * of a uniform grid covering the battle stage. Pairs are sorted by entity so that they are solved in the same order on every peer.
+	 * \param minMargin is how far the bodies can be pushed in total before the pairs are built again
+	 */
+	void BuildCollisionPairs(float minMargin = 0.0f);
+	/**
+	 * \brief IsPushedOutOfBroadPhase is a method that returns true when an overlap pushed the body further than half the margin
+	 * of the broad phase, from where it was when the pairs were built. Its new contacts could then be missing from the pairs.
+	 */
+	[[nodiscard]] bool IsPushedOutOfBroadPhase(core::Entity entity) const;
+
 	core::EntityManager& entityManager_;
 	BodyManager bodyManager_;
 	CircleManager colManager_;
+	//Broad phase, kept between frames to avoid allocations
+	core::GridBroadPhase broadPhase_{ core::Vec2f(BATTLE_STAGE_WIDTH, BATTLE_STAGE_HEIGHT) };
+	//Positions of the bodies when the pairs were built, by entity
+	std::vector<core::Vec2f> broadPhasePositions_;
 	core::Action<core::Entity, core::Entity> onTriggerAction_;
+#ifndef GAME_HEADLESS
 	//Used for debug
 	sf::Vector2f center_{};
 	sf::Vector2f windowSize_{};
+#endif
 };
 
 }
@@ -0,0 +1,123 @@
+#pragma once
+#include <array>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include "game_globals.h"
+#include "maths/angle.h"
+#include "maths/vec2.h"
+#include "network/packet_type.h"
+
+namespace game
+{
+class GameManager;
+
+/**
+ * \brief REPLAY_MAGIC starts every replay file, followed by REPLAY_VERSION.
+ */
+constexpr std::array<char, 4> REPLAY_MAGIC{ 'R', 'B', 'R', 'P' };
+constexpr std::uint8_t REPLAY_VERSION = 1;
+/**
+ * \brief REPLAY_INPUT_BIT_NMB is the number of bits of each input in the replay, enough for all the PlayerInputEnum flags.
+ */
+constexpr std::uint8_t REPLAY_INPUT_BIT_NMB = 6;
+/**
+ * \brief REPLAY_CHUNK_FRAME_NMB is the number of frames after which the ReplayWriter writes a chunk, at the next validated frame.
+ */
+constexpr Frame REPLAY_CHUNK_FRAME_NMB = 50;
+
+/**
+ * \brief ReplaySpawn is the spawn position and rotation of a player at the start of the replay.
+ */
+struct ReplaySpawn
+{
+    core::Vec2f position{};
+    core::Degree rotation{};
+};
+
+/**
+ * \brief ReplayChunk is a struct of consecutive frames of a replay, from firstFrame to lastFrame.
+ * physicsState is the hash of the world after lastFrame, it is used to find the first frame that desyncs.
+ */
+struct ReplayChunk
+{
+    Frame firstFrame = 0;
+    Frame lastFrame = 0;
+    PhysicsState physicsState = 0;
+    /**
+     * \brief inputs has the inputs of all the players of the first frame, then of the second frame, etc...
+     */
+    std::vector<PlayerInput> inputs;
+};
+
+/**
+ * \brief ReplayWriter is a class that records the confirmed inputs of a game in a replay file.
+ * The file starts with a header (REPLAY_MAGIC, REPLAY_VERSION, the player count and the spawns of the players),
+ * followed by chunks of frames. A chunk has its frame count, the physics state of its last frame,
+ * and the inputs of its frames packed on REPLAY_INPUT_BIT_NMB bits each.
+ * The values are written in the native byte order, like the packets.
+ */
+class ReplayWriter
+{
+public:
+    ReplayWriter() = default;
+    ~ReplayWriter();
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    /**
+     * \brief Open is a method that creates the replay file and writes its header, when the game starts.
+     * The players need to be spawned.
+     * \return false if the file could not be created
+     */
+    bool Open(std::string_view path, const GameManager& gameManager);
+    /**
+     * \brief WriteValidatedFrames is a method that adds the inputs of the frames validated since the last call,
+     * and writes a chunk once it has at least REPLAY_CHUNK_FRAME_NMB frames.
+     * It is called by the server after each validation, while the inputs are still in the window.
+     */
+    void WriteValidatedFrames(const GameManager& gameManager);
+    /**
+     * \brief Close is a method that writes the last chunk and closes the file.
+     */
+    void Close();
+    [[nodiscard]] bool IsOpen() const { return file_.is_open(); }
+private:
+    void WriteChunk();
+
+    std::ofstream file_;
+    PlayerNumber playerNmb_ = 0;
+    Frame lastWrittenFrame_ = 0;
+    Frame chunkFirstFrame_ = 1;
+    PhysicsState chunkPhysicsState_ = 0;
+    std::vector<PlayerInput> chunkInputs_;
+    std::vector<std::uint8_t> packedInputs_;
+};
+
+/**
+ * \brief ReplayReader is a class that reads the replay files written by the ReplayWriter, one chunk at a time.
+ */
+class ReplayReader
+{
+public:
+    /**
+     * \brief Open is a method that opens the replay file and reads its header.
+     * \return false if the file could not be opened or is not a replay of this version
+     */
+    bool Open(std::string_view path);
+    [[nodiscard]] PlayerNumber GetPlayerNmb() const { return playerNmb_; }
+    [[nodiscard]] const ReplaySpawn& GetSpawn(PlayerNumber playerNumber) const { return spawns_[playerNumber]; }
+    /**
+     * \brief ReadChunk is a method that reads the next chunk of the replay.
+     * \return false at the end of the replay, or if the file is truncated
+     */
+    bool ReadChunk(ReplayChunk& chunk);
+private:
+    std::ifstream file_;
+    PlayerNumber playerNmb_ = 0;
+    std::array<ReplaySpawn, MAX_PLAYER_NMB> spawns_{};
+    Frame nextFrame_ = 1;
+    std::vector<std::uint8_t> packedInputs_;
+};
+}
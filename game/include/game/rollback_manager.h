@@ -7,6 +7,9 @@
 #include "engine/transform.h"
 #include "network/packet_type.h"
 
+#include <bitset>
+#include <chrono>
+
 namespace game
 {
 class GameManager;
@@ -18,13 +21,70 @@ class GameManager;
 struct CreatedEntity
 {
     core::Entity entity = core::INVALID_ENTITY;
+    /**
+     * \brief generation is used to skip the entity if it was already destroyed and its index recycled.
+     */
+    core::Generation generation = 0;
     Frame createdFrame = 0;
 };
 
+/**
+ * \brief FrameSnapshot is a struct that contains a copy of the rollback-relevant components at the end of a frame.
+ * It is used by the RollbackManager to go back to any frame of the window instead of only the last validated frame.
+ */
+struct FrameSnapshot
+{
+    Frame frame = INVALID_FRAME;
+    core::PackedComponents<Body> bodies;
+    core::PackedComponents<Circle> cols;
+    std::vector<PlayerCharacter> playerCharacters;
+    std::vector<Glove> gloves;
+};
+
+/**
+ * \brief PlayerInputBuffer is a class that stores the inputs of one player in a ring indexed by frame modulo WINDOW_BUFFER_SIZE.
+ * Each stored input has a confirmed bit telling if it was received or if it is a prediction.
+ * The frames after the last received frame are not stored, they are predicted by repeating the last received input.
+ */
+class PlayerInputBuffer
+{
+public:
+    PlayerInputBuffer();
+    /**
+     * \brief GetInput is a method that returns the received or predicted input of the given frame in O(1).
+     * The frame needs to be inside the input window.
+     */
+    [[nodiscard]] PlayerInput GetInput(Frame frame) const;
+    /**
+     * \brief IsConfirmed is a method that returns true if the input of the given frame was received and is not a prediction.
+     */
+    [[nodiscard]] bool IsConfirmed(Frame frame) const;
+    /**
+     * \brief SetInput is a method that sets the received input of the given frame in O(1).
+     * When the frame is newer than the last received frame, the frames in between keep the predicted input.
+     * \return the given frame if it changes the input that was used for this frame so far, INVALID_FRAME otherwise
+     */
+    Frame SetInput(Frame frame, PlayerInput input);
+    [[nodiscard]] Frame GetLastReceivedFrame() const { return lastReceivedFrame_; }
+    /**
+     * \brief GetFirstMissingFrame is a method that returns the first frame whose input was not received,
+     * all the frames before it being confirmed. The frames that left the window are not waited for anymore.
+     */
+    [[nodiscard]] Frame GetFirstMissingFrame() const { return firstMissingFrame_; }
+private:
+    void AdvanceFirstMissingFrame();
+
+    std::array<PlayerInput, WINDOW_BUFFER_SIZE> inputs_{};
+    std::bitset<WINDOW_BUFFER_SIZE> confirmed_;
+    Frame lastReceivedFrame_ = 0;
+    Frame firstMissingFrame_ = 1;
+};
+
 /**
  * \brief RollbackManager is a class that manages all the rollback mechanisms of the game.
- * It contains two copies of the world (PhysicsManager, TransformManager, etc...), the current one and the validated one.
- * When receiving new information, it can reupdate the current copy of the world.
+ * It contains the current copy of the world (PhysicsManager, TransformManager, etc...) and a ring of snapshots of
+ * the previous frames, the oldest one being the last validated frame.
+ * When receiving new information, it can go back to the frame before the corrected input and reupdate the current copy of the world.
  */
 class RollbackManager final : public OnTriggerInterface
 {
@@ -32,6 +92,7 @@ public:
     explicit RollbackManager(GameManager& gameManager, core::EntityManager& entityManager);
     /**
      * \brief SimulateToCurrentFrame is a method that simulates all players with new inputs, method call only by the clients to update the current state of the visuals
+     * It only rolls back to the first mispredicted frame, and only simulates the new frames when all predictions were correct.
      */
     void SimulateToCurrentFrame();
     /**
@@ -51,15 +112,19 @@ public:
      */
     void ValidateFrame(Frame newValidateFrame);
     /**
-     * \brief ConfirmFrame is a method that confirms the new validate frame by checking the Physics State checksums
+     * \brief ConfirmFrame is a method that confirms the new validate frame by checking the Physics State hashes
      * It is called by the clients when receiving Confirm Frame packet
      * \param newValidatedFrame is the new frame that is validated
      * \param serverPhysicsState is the physics state given by the server through a packet
      */
-    void ConfirmFrame(Frame newValidatedFrame, const std::array<PhysicsState, MAX_PLAYER_NMB>& serverPhysicsState);
-    [[nodiscard]] PhysicsState GetValidatePhysicsState(PlayerNumber playerNumber) const;
+    void ConfirmFrame(Frame newValidatedFrame, PhysicsState serverPhysicsState);
+    /**
+     * \brief GetValidatePhysicsState returns the hash of the world at the last validated frame, computed by ValidateFrame.
+     */
+    [[nodiscard]] PhysicsState GetValidatePhysicsState() const { return validatedPhysicsState_; }
     [[nodiscard]] Frame GetLastValidateFrame() const { return lastValidatedFrame_; }
-    [[nodiscard]] Frame GetLastReceivedFrame(PlayerNumber playerNumber) const { return lastReceivedFrame_[playerNumber]; }
+    [[nodiscard]] Frame GetLastReceivedFrame(PlayerNumber playerNumber) const { return inputs_[playerNumber].GetLastReceivedFrame(); }
+    [[nodiscard]] Frame GetFirstMissingInputFrame(PlayerNumber playerNumber) const { return inputs_[playerNumber].GetFirstMissingFrame(); }
     [[nodiscard]] Frame GetCurrentFrame() const { return currentFrame_; }
     [[nodiscard]] Frame GetCurrentInputFrame() const { return currentInputFrame_; }
     [[nodiscard]] const core::TransformManager& GetTransformManager() const { return currentTransformManager_; }
@@ -86,10 +151,22 @@ public:
     void DestroyEntity(core::Entity entity);
 
     void OnTrigger(core::Entity entity1, core::Entity entity2) override;
-    [[nodiscard]] const std::array<PlayerInput, WINDOW_BUFFER_SIZE>& GetInputs(PlayerNumber playerNumber) const
+    /**
+     * \brief GetInputAtFrame is a method that returns the received or predicted input of a player at the given frame.
+     */
+    [[nodiscard]] PlayerInput GetInputAtFrame(PlayerNumber playerNumber, Frame frame) const;
+    [[nodiscard]] bool IsInputConfirmed(PlayerNumber playerNumber, Frame frame) const
     {
-        return inputs_[playerNumber];
+        return inputs_[playerNumber].IsConfirmed(frame);
     }
+    /**
+     * \brief GetSimulatedFrameNmb returns the number of frames simulated by SimulateToCurrentFrame, re-simulated frames included.
+     */
+    [[nodiscard]] std::uint64_t GetSimulatedFrameNmb() const { return simulatedFrameNmb_; }
+    /**
+     * \brief GetLastSimulateDuration returns the time spent in the last call of SimulateToCurrentFrame.
+     */
+    [[nodiscard]] std::chrono::nanoseconds GetLastSimulateDuration() const { return lastSimulateDuration_; }
 private:
     /**
      * \brief Player to Glove collision logic
@@ -112,7 +189,26 @@ private:
      * \param mod a multiplier to apply to the punchee's velocity
      */
     void HandlePunchCollision(Body gloveBody, core::Entity gloveEntity, Body otherBody, core::Entity otherEntity, float mod);
-    [[nodiscard]] PlayerInput GetInputAtFrame(PlayerNumber playerNumber, Frame frame) const;
+    /**
+     * \brief SimulateFrame is a method that copies the players inputs of the given frame and simulates one frame of the current world.
+     * \param frame is the simulated frame
+     */
+    void SimulateFrame(Frame frame);
+    /**
+     * \brief SaveSnapshot is a method that copies the current world in the snapshot ring at the given frame.
+     */
+    void SaveSnapshot(Frame frame);
+    /**
+     * \brief LoadSnapshot is a method that reverts the current world to the snapshot of the given frame.
+     * The frame needs to be inside the snapshot window.
+     */
+    void LoadSnapshot(Frame frame);
+    /**
+     * \brief ComputePhysicsState is a method that hashes the rollback components of the players and their gloves,
+     * in the current world that was just simulated and saved.
+     * It goes by player number and never hashes entities, so peers that spawned the players in another order agree.
+     */
+    [[nodiscard]] PhysicsState ComputePhysicsState() const;
     GameManager& gameManager_;
     core::EntityManager& entityManager_;
     /**
@@ -123,15 +219,18 @@ private:
     PlayerCharacterManager currentPlayerManager_;
     GloveManager currentGloveManager_;
     /**
-     * Last Validated (confirm frame) Component Managers used for rollback
+     * \brief snapshots_ is a ring of the world state at the end of each frame, indexed by frame modulo WINDOW_BUFFER_SIZE.
+     * The snapshot of lastValidatedFrame_ is the validated (confirm frame) state.
      */
-    PhysicsManager lastValidatedPhysicsManager_;
-    PlayerCharacterManager lastValidatedPlayerManager_;
-    GloveManager lastValidatedGloveManager_;
+    std::array<FrameSnapshot, WINDOW_BUFFER_SIZE> snapshots_{};
     /**
      * \brief lastValidatedFrame_ is the last validated frame from the server side.
      */
     Frame lastValidatedFrame_ = 0;
+    /**
+     * \brief validatedPhysicsState_ is the hash of the snapshot of lastValidatedFrame_.
+     */
+    PhysicsState validatedPhysicsState_ = 0;
     /**
      * \brief currentFrame_ is the current frame on the client side.
      */
@@ -141,14 +240,31 @@ private:
      * \brief testedFrame_ is the current simulated frame used mainly for entity creation and collision.
      */
     Frame testedFrame_ = 0;
+    /**
+     * \brief lastSimulatedFrame_ is the last frame whose snapshot is stored.
+     */
+    Frame lastSimulatedFrame_ = 0;
+    /**
+     * \brief firstMispredictedFrame_ is the earliest frame whose input changed since the last simulation.
+     * When it is INVALID_FRAME, all the predicted frames are still correct and only the new frames are simulated.
+     */
+    Frame firstMispredictedFrame_ = INVALID_FRAME;
+    /**
+     * \brief stateFrame_ is the frame the current world is at, used to avoid loading a snapshot that is already there.
+     */
+    Frame stateFrame_ = 0;
 
     /**
      * \brief used to avoid playing sounds and effects multiple times.
      */
     bool reSimulating_ = false;
+    /**
+     * \brief simulatedFrameNmb_ and lastSimulateDuration_ profile SimulateToCurrentFrame for the rollback benchmark.
+     */
+    std::uint64_t simulatedFrameNmb_ = 0;
+    std::chrono::nanoseconds lastSimulateDuration_{};
 
-    std::array<std::uint32_t, MAX_PLAYER_NMB> lastReceivedFrame_{};
-    std::array<std::array<PlayerInput, WINDOW_BUFFER_SIZE>, MAX_PLAYER_NMB> inputs_{};
+    std::array<PlayerInputBuffer, MAX_PLAYER_NMB> inputs_{};
     /**
      * \brief Array containing all the created entities in the window between the confirm frame and the current frame
      * to destroy them when rollbacking.
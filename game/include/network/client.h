@@ -29,7 +29,14 @@ public:
     virtual void ReceivePacket(const Packet* packet);
 
     void Update(sf::Time dt) override;
+
+    [[nodiscard]] const ClientGameManager& GetGameManager() const { return gameManager_; }
 protected:
+    /**
+     * \brief ReceivePlayerInput is a method that applies the inputs of a PlayerInputPacket,
+     * received alone or in a MultiInputPacket.
+     */
+    void ReceivePlayerInput(const PlayerInputPacket& playerInputPacket);
 
     ClientGameManager gameManager_;
     ClientId clientId_ = INVALID_CLIENT_ID;
@@ -0,0 +1,104 @@
+#pragma once
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+namespace game
+{
+/**
+ * \brief MAX_DATAGRAM_SIZE is the size of the receive buffers, game packets are far smaller. Longer datagrams are dropped.
+ */
+constexpr std::size_t MAX_DATAGRAM_SIZE = 2048;
+/**
+ * \brief MAX_DATAGRAM_BATCH is the number of datagrams received or sent with one system call.
+ */
+constexpr std::size_t MAX_DATAGRAM_BATCH = 64;
+
+/**
+ * \brief ReceivedDatagram is a view on a datagram read by a DatagramBatch, valid until the next Receive.
+ */
+struct ReceivedDatagram
+{
+    const char* data = nullptr;
+    std::size_t size = 0;
+    sf::IpAddress address;
+    unsigned short port = 0;
+};
+
+/**
+ * \brief GetEndpointKey is a function that packs an UDP endpoint in one integer, to use it as a map key.
+ */
+inline std::uint64_t GetEndpointKey(sf::IpAddress address, unsigned short port)
+{
+    return (static_cast<std::uint64_t>(address.toInteger()) << 16u) | port;
+}
+
+/**
+ * \brief DatagramBatch batches the UDP system calls of a socket: recvmmsg and sendmmsg on Linux,
+ * a loop on the sf::UdpSocket on the other platforms.
+ * A payload is copied once with AddPayload and then queued for as many endpoints as needed, until Flush.
+ */
+class DatagramBatch
+{
+public:
+    using PayloadId = std::size_t;
+
+    explicit DatagramBatch(sf::UdpSocket& udpSocket);
+
+    /**
+     * \brief Receive is a method that reads up to MAX_DATAGRAM_BATCH datagrams.
+     * \return the number of datagrams read, zero when the socket would block
+     */
+    std::size_t Receive();
+
+    [[nodiscard]] const ReceivedDatagram& GetReceivedDatagram(std::size_t index) const { return receivedDatagrams_[index]; }
+
+    /**
+     * \brief AddPayload is a method that copies a serialized packet, to send it with QueueSend.
+     */
+    PayloadId AddPayload(const sf::Packet& packet);
+    PayloadId AddPayload(const char* data, std::size_t size);
+
+    void QueueSend(PayloadId payloadId, sf::IpAddress address, unsigned short port);
+
+    /**
+     * \brief Flush is a method that sends all the queued datagrams and clears the payloads.
+     */
+    void Flush();
+
+    [[nodiscard]] bool IsEmpty() const { return queuedDatagrams_.empty(); }
+private:
+    struct Payload
+    {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+    struct QueuedDatagram
+    {
+        PayloadId payloadId = 0;
+        sf::IpAddress address;
+        unsigned short port = 0;
+    };
+
+    sf::UdpSocket& udpSocket_;
+    std::vector<std::array<char, MAX_DATAGRAM_SIZE>> receiveBuffers_;
+    std::array<ReceivedDatagram, MAX_DATAGRAM_BATCH> receivedDatagrams_{};
+    std::vector<char> payloadBuffer_;
+    std::vector<Payload> payloads_;
+    std::vector<QueuedDatagram> queuedDatagrams_;
+#ifdef __linux__
+    std::array<mmsghdr, MAX_DATAGRAM_BATCH> messages_{};
+    std::array<iovec, MAX_DATAGRAM_BATCH> iovecs_{};
+    std::array<sockaddr_in, MAX_DATAGRAM_BATCH> addresses_{};
+#endif
+};
+}
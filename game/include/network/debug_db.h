@@ -3,42 +3,83 @@
 #ifdef ENABLE_SQLITE
 #include "network/packet_type.h"
 #include "game/physics_manager.h"
+#include "utils/spsc_ring.h"
 
-#include <string_view>
+#include <atomic>
 #include <condition_variable>
+#include <mutex>
+#include <string_view>
 #include <thread>
-#include <vector>
+#include <variant>
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace game
 {
 
 struct DbPhysicsState
 {
-    std::array<PhysicsState, maxPlayerNmb> serverStates{};
-    std::array<PhysicsState, maxPlayerNmb> localStates{};
+    PhysicsState serverState{};
+    PhysicsState localState{};
     Frame lastLocalValidateFrame{};
     Frame validateFrame{};
 };
 
+struct DbInput
+{
+    PlayerNumber playerNumber{};
+    Frame frame{};
+    PlayerInput input{};
+};
+
+/**
+ * \brief DB_RECORD_RING_SIZE is the number of records the game thread can store before the writer thread catches up.
+ */
+constexpr std::size_t DB_RECORD_RING_SIZE = 4096;
+
+/**
+ * \brief DebugDatabase is a class that stores the received inputs and the physics states in a SQLite database.
+ * The game thread pushes fixed size records in a lock-free ring, without formatting nor allocating,
+ * and a writer thread inserts them with prepared statements, one transaction per batch, in WAL mode.
+ * When the ring is full, the records are dropped instead of blocking the game thread.
+ */
 class DebugDatabase
 {
 public:
+    DebugDatabase() = default;
+    ~DebugDatabase();
+    DebugDatabase(const DebugDatabase&) = delete;
+    DebugDatabase& operator=(const DebugDatabase&) = delete;
+
     void Open(std::string_view path);
     void StorePacket(const PlayerInputPacket* inputPacket);
     void StorePhysicsState(const DbPhysicsState& physicsState);
+    /**
+     * \brief Close is a method that waits for the writer thread to insert the remaining records and closes the database.
+     */
     void Close();
 private:
+    using Record = std::variant<DbInput, DbPhysicsState>;
+
     void Loop();
+    /**
+     * \brief WriteBatch is a method that inserts all the records of the ring in one transaction.
+     */
+    void WriteBatch();
+    void Execute(const char* sql) const;
     void CreateTables() const;
     sqlite3* db = nullptr;
-    std::atomic<bool> isOver_ = false;
+    sqlite3_stmt* insertInputStatement_ = nullptr;
+    sqlite3_stmt* insertPhysicsStateStatement_ = nullptr;
+    core::SpscRing<Record, DB_RECORD_RING_SIZE> records_;
+    //Only read by Close, so the game thread does not log when the ring is full
+    std::size_t droppedRecordNmb_ = 0;
     std::thread t_;
-    mutable std::mutex m_;
+    std::mutex m_;
     std::condition_variable cv_;
-    std::vector<std::string> commands_;
+    std::atomic<bool> isOver_ = false;
 };
 
 }
-#endif
\ No newline at end of file
+#endif
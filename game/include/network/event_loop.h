@@ -0,0 +1,52 @@
+#pragma once
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <vector>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <SFML/Network/SocketSelector.hpp>
+#endif
+
+#include "utils/timer_wheel.h"
+
+namespace game
+{
+/**
+ * \brief EventLoop is the I/O layer of the servers. Wait sleeps until a registered socket is readable
+ * or the next timer of its TimerWheel is due, instead of busy polling the non-blocking sockets.
+ * It uses epoll on Linux and sf::SocketSelector on the other platforms.
+ */
+class EventLoop
+{
+public:
+    EventLoop();
+    ~EventLoop();
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    void Add(sf::Socket& socket);
+    void Remove(sf::Socket& socket);
+
+    /**
+     * \brief Wait is a method that blocks until a socket is readable or a timer is due, then calls the due timers.
+     * \return the readable sockets, valid until the next call
+     */
+    const std::vector<sf::Socket*>& Wait();
+
+    core::TimerWheel& GetTimerWheel() { return timerWheel_; }
+private:
+#ifdef __linux__
+    int epollFd_ = -1;
+    std::vector<epoll_event> events_;
+#else
+    sf::SocketSelector selector_;
+    std::vector<sf::Socket*> sockets_;
+#endif
+    std::vector<sf::Socket*> readySockets_;
+    core::TimerWheel timerWheel_;
+    sf::Clock clock_;
+};
+}
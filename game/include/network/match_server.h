@@ -0,0 +1,181 @@
+#pragma once
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "datagram_batch.h"
+#include "event_loop.h"
+#include "network_server.h"
+#include "reliable_channel.h"
+#include "server.h"
+#include "spectator_relay.h"
+#include "utils/thread_pool.h"
+
+namespace game
+{
+/**
+ * \brief Match is a Server hosting one game inside a MatchServer. It never touches the sockets:
+ * the MatchServer gives it its received packets, updates it on a worker thread and then sends the packets it generated.
+ */
+class Match final : public Server
+{
+public:
+    /**
+     * \brief SentPacket is a packet generated by the Match, already serialized on its worker thread.
+     * The unreliable packets are complete datagrams, the reliable ones are given to the ReliableChannel of each client.
+     */
+    struct SentPacket
+    {
+        sf::Packet packet;
+        bool reliable = false;
+    };
+
+    explicit Match(unsigned short udpPort);
+
+    void SendReliablePacket(const Packet& packet) override;
+
+    void SendUnreliablePacket(const Packet& packet) override;
+
+    void Begin() override;
+
+    /**
+     * \brief Update is a method that processes the received packets. It is called on a worker thread.
+     */
+    void Update(sf::Time dt) override;
+
+    void End() override;
+
+    void PushReceivedPacket(const PacketVariant& packet);
+
+    /**
+     * \brief HasReceivedPackets is a method that returns true when the Match needs an Update:
+     * it received packets, or it still has inputs to broadcast.
+     */
+    [[nodiscard]] bool HasReceivedPackets() const { return !receivedPackets_.empty() || HasPendingInputs(); }
+
+    std::span<SentPacket> GetSentPackets() { return { sentPackets_.data(), sentPacketNmb_ }; }
+
+    /**
+     * \brief ClearSentPackets is a method that empties the sent packets, keeping their buffers for the next ones.
+     */
+    void ClearSentPackets() { sentPacketNmb_ = 0; }
+
+    /**
+     * \brief GetSpectatorFrames is a method that gives the frames validated since the last Update,
+     * they are taken by the SpectatorRelay of the match on the main thread.
+     */
+    SpectatorFrames& GetSpectatorFrames() { return spectatorFrames_; }
+
+protected:
+    void SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber) override;
+
+private:
+    SentPacket& AddSentPacket(bool reliable);
+
+    std::vector<PacketVariant> receivedPackets_;
+    //Pool of serialized packets, only the first sentPacketNmb_ are in use
+    std::vector<SentPacket> sentPackets_;
+    std::size_t sentPacketNmb_ = 0;
+    unsigned short udpPort_ = 0;
+};
+
+/**
+ * \brief MatchServer is a network server hosting many concurrent Match in one process.
+ * New clients fill the current match, UDP datagrams are routed to the match of their endpoint,
+ * and the matches that received packets are updated in parallel on a ThreadPool.
+ * Like NetworkServer, Update sleeps in an EventLoop until the socket is readable or the fixed tick is due.
+ * Spectators subscribe to a match with a SpectatePacket, the SpectatorRelay of the match sends them its validated frames
+ * from the main thread, so the workers do not pay for them.
+ */
+class MatchServer final : public core::SystemInterface
+{
+public:
+    explicit MatchServer(std::size_t workerNmb);
+
+    void Begin() override;
+
+    void Update(sf::Time dt) override;
+
+    void End() override;
+
+    void SetPort(unsigned short port);
+
+    /**
+     * \brief SetInputBroadcastPeriod is a method that sets the input broadcast period of the matches opened afterwards.
+     * \see Server::SetInputBroadcastPeriod
+     */
+    void SetInputBroadcastPeriod(float period);
+
+    /**
+     * \brief SetPlayerNmb is a method that sets the number of players of the matches opened afterwards.
+     */
+    void SetPlayerNmb(PlayerNumber playerNmb);
+
+    /**
+     * \brief SetReplayFolder is a method that makes the matches opened afterwards record a replay,
+     * named after their MatchId, in the given folder.
+     */
+    void SetReplayFolder(std::string_view folder);
+
+    [[nodiscard]] bool IsOpen() const { return isOpen_; }
+
+    [[nodiscard]] std::size_t GetMatchNmb() const { return matches_.size(); }
+
+private:
+    /**
+     * \brief MatchClient is a client that joined a match, with its UDP endpoint and its ReliableChannel.
+     */
+    struct MatchClient
+    {
+        ReliableChannel channel;
+        ClientInfo clientInfo;
+        MatchId matchId = INVALID_MATCH_ID;
+    };
+    /**
+     * \brief HostedMatch is the main thread side of a Match: the clients routed to it.
+     */
+    struct HostedMatch
+    {
+        std::unique_ptr<Match> match;
+        std::unique_ptr<SpectatorRelay> spectatorRelay;
+        std::array<ClientId, MAX_PLAYER_NMB> clients{};
+        std::uint32_t clientNmb = 0;
+    };
+
+    void ReceiveUdpPackets();
+    void RouteDatagram(const ReceivedDatagram& datagram);
+    void ReceiveConnectionDatagram(const ReceivedDatagram& datagram);
+    void JoinMatch(const ReceivedDatagram& datagram, ReliableChannel& channel, const JoinPacket& joinPacket);
+    void SpectateMatch(const ReceivedDatagram& datagram, ReliableChannel& channel, const SpectatePacket& spectatePacket);
+    void SendMatchPackets(HostedMatch& hostedMatch);
+    void UpdateChannels(sf::Time dt);
+    void SendChannelDatagrams(MatchClient& client, sf::Time dt);
+    void CloseMatch(MatchId matchId);
+
+    core::ThreadPool threadPool_;
+    EventLoop eventLoop_;
+    sf::UdpSocket udpSocket_;
+    DatagramBatch datagramBatch_{ udpSocket_ };
+
+    std::unordered_map<ClientId, MatchClient> clients_;
+    std::unordered_map<std::uint64_t, ClientId> udpEndpoints_;
+    std::unordered_map<std::uint64_t, MatchId> spectatorEndpoints_;
+    std::unordered_map<MatchId, HostedMatch> matches_;
+    std::vector<Match*> updatedMatches_;
+    std::vector<MatchId> closedMatches_;
+
+    MatchId nextMatchId_ = 0;
+    MatchId fillingMatchId_ = INVALID_MATCH_ID;
+    unsigned short udpPort_ = 12345;
+    float inputBroadcastPeriod_ = 0.0f;
+    PlayerNumber playerNmb_ = DEFAULT_PLAYER_NMB;
+    std::string replayFolder_;
+    bool isOpen_ = false;
+};
+}
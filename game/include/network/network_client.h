@@ -1,8 +1,10 @@
 #pragma once
 #include "client.h"
-#include <SFML/Network/TcpSocket.hpp>
+#include "reliable_channel.h"
 #include <SFML/Network/UdpSocket.hpp>
 
+#include <array>
+
 #ifdef ENABLE_SQLITE
 #include "network/debug_db.h"
 #endif
@@ -10,7 +12,8 @@
 namespace game
 {
 /**
- * \brief NetworkClient is a network client that uses SFML sockets.
+ * \brief NetworkClient is a network client that uses one SFML UDP socket.
+ * The reliable packets go through a ReliableChannel to the server.
  */
 class NetworkClient final : public Client
 {
@@ -24,11 +27,6 @@ public:
 		GAME
 
 	};
-	enum class PacketSource
-	{
-		TCP,
-		UDP
-	};
 	void Begin() override;
 
 	void Update(sf::Time dt) override;
@@ -39,20 +37,23 @@ public:
 
 	void Draw(sf::RenderTarget& renderTarget) override;
 
-	void SendReliablePacket(std::unique_ptr<Packet> packet) override;
+	void SendReliablePacket(const Packet& packet) override;
 
-	void SendUnreliablePacket(std::unique_ptr<Packet> packet) override;
+	void SendUnreliablePacket(const Packet& packet) override;
 	void SetPlayerInput(PlayerInput playerInput);
 
 	void ReceivePacket(const Packet* packet) override;
 private:
-	void ReceiveNetPacket(sf::Packet& packet, PacketSource source);
+	void ReceiveNetPacket(sf::Packet& packet);
+	void SendDatagram(const char* data, std::size_t size);
 	sf::UdpSocket udpSocket_;
-	sf::TcpSocket tcpSocket_;
+	ReliableChannel channel_;
+	std::array<char, sf::UdpSocket::MaxDatagramSize> receiveBuffer_{};
+	//Reused for every packet, sf::Packet keeps its buffer when cleared
+	sf::Packet sendingPacket_;
 
 	std::string serverAddress_ = "localhost";
-	unsigned short serverTcpPort_ = 12345;
-	unsigned short serverUdpPort_ = 0;
+	unsigned short serverPort_ = 12345;
 
 
 	State currentState_ = State::NONE;
@@ -1,9 +1,13 @@
 #pragma once
 #include <SFML/Network/IpAddress.hpp>
-#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/UdpSocket.hpp>
 
-#include "network_client.h"
+#include "datagram_batch.h"
+#include "debug_db.h"
+#include "event_loop.h"
+#include "reliable_channel.h"
 #include "server.h"
+#include "spectator_relay.h"
 #include "game/game_globals.h"
 
 namespace game
@@ -20,20 +24,18 @@ struct ClientInfo
 };
 
 /**
- * \brief NetworkServer is a network server using SFML sockets.
+ * \brief NetworkServer is a network server using one SFML UDP socket for all the players.
+ * Each player has a ReliableChannel for the reliable packets, opened by its join packet.
+ * Update sleeps in an EventLoop until the socket is readable or the fixed tick is due, and then drains the socket.
+ * The UDP datagrams are received and sent in batches, the packets are sent at the end of Update.
+ * Spectators connect with a SpectatePacket instead of a JoinPacket, a SpectatorRelay sends them the validated frames.
  */
 class NetworkServer final : public Server
 {
 public:
-    enum class PacketSocketSource
-    {
-        TCP,
-        UDP
-    };
-
-    void SendReliablePacket(std::unique_ptr<Packet> packet) override;
+    void SendReliablePacket(const Packet& packet) override;
 
-    void SendUnreliablePacket(std::unique_ptr<Packet> packet) override;
+    void SendUnreliablePacket(const Packet& packet) override;
 
     void Begin() override;
 
@@ -41,7 +43,7 @@ public:
 
     void End() override;
 
-    void SetTcpPort(unsigned short i);
+    void SetPort(unsigned short port);
 
     [[nodiscard]] bool IsOpen() const;
     
@@ -49,13 +51,21 @@ protected:
     void SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber) override;
 
 private:
-    void ProcessReceivePacket(std::unique_ptr<Packet> packet,
-        PacketSocketSource packetSource,
-        sf::IpAddress address = "localhost",
-        unsigned short port = 0);
-    void ReceiveNetPacket(sf::Packet& packet, PacketSocketSource packetSource,
-                          sf::IpAddress address = "localhost",
-                          unsigned short port = 0);
+    /**
+     * \brief Connection is a remote client, identified by its UDP endpoint.
+     */
+    struct Connection
+    {
+        sf::IpAddress address;
+        unsigned short port = 0;
+        ReliableChannel channel;
+    };
+
+    void ProcessReceivePacket(const Packet& packet, const Connection& connection);
+    void ReceiveNetPacket(sf::Packet& packet, const Connection& connection);
+    void ReceiveUdpPackets();
+    Connection* FindConnection(const ReceivedDatagram& datagram);
+    void UpdateConnections(sf::Time dt);
 
     enum ServerStatus
     {
@@ -63,17 +73,22 @@ private:
         STARTED = 1u << 1u,
         FIRST_PLAYER_CONNECT = 1u << 2u,
     };
+    EventLoop eventLoop_;
     sf::UdpSocket udpSocket_;
-    sf::TcpListener tcpListener_;
-    std::array<sf::TcpSocket, MAX_PLAYER_NMB> tcpSockets_;
+    DatagramBatch datagramBatch_{ udpSocket_ };
+    SpectatorRelay spectatorRelay_{ datagramBatch_ };
+    //Reused for every packet, so that their buffers are only allocated once
+    sf::Packet receivedPacket_;
+    sf::Packet sendingPacket_;
+    std::array<Connection, MAX_PLAYER_NMB> connections_;
 
     std::array<ClientInfo, MAX_PLAYER_NMB> clientInfoMap_{};
 
 
-    unsigned short tcpPort_ = 12345;
     unsigned short udpPort_ = 12345;
-    std::uint32_t lastSocketIndex_ = 0;
-    std::uint8_t status_ = 0;
+    std::uint32_t connectionNmb_ = 0;
+    //One FIRST_PLAYER_CONNECT bit per player
+    std::uint16_t status_ = 0;
 
 #ifdef ENABLE_SQLITE
     DebugDatabase db_;
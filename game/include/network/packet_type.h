@@ -6,9 +6,12 @@
 #include <SFML/Network/Packet.hpp>
 
 #include "game/game_globals.h"
-#include <memory>
+#include <algorithm>
 #include <chrono>
+#include <optional>
+#include <variant>
 
+#include "utils/assert.h"
 #include "utils/conversion.h"
 
 namespace game
@@ -23,13 +26,18 @@ enum class PacketType : std::uint8_t
     JOIN_ACK,
     WIN_GAME,
     PING,
+    MULTI_INPUT,
+    SPECTATE,
+    SPECTATE_START,
+    SPECTATOR_INPUT,
+    SPECTATOR_ACK,
     NONE,
 };
 
 /**
- * \brief PhysicsState is the type of the physics state checksum
+ * \brief PhysicsState is the type of the 64-bit hash of the validated world state
  */
-using PhysicsState = std::uint16_t;
+using PhysicsState = std::uint64_t;
 
 /**
  * \brief Packet is a interface that defines what a packet with a PacketType.
@@ -40,7 +48,7 @@ struct Packet
     PacketType packetType = PacketType::NONE;
 };
 
-inline sf::Packet& operator<<(sf::Packet& packetReceived, Packet& packet)
+inline sf::Packet& operator<<(sf::Packet& packetReceived, const Packet& packet)
 {
     const auto packetType = static_cast<std::uint8_t>(packet.packetType);
     packetReceived << packetType;
@@ -86,7 +94,7 @@ sf::Packet& operator>>(sf::Packet& packet, std::array<T, N>& t)
 }
 
 /**
- * \brief JoinPacket is a TCP Packet that is sent by a client to the server to join a game.
+ * \brief JoinPacket is a reliable Packet that is sent by a client to the server to join a game.
  */
 struct JoinPacket : TypedPacket<PacketType::JOIN>
 {
@@ -105,7 +113,7 @@ inline sf::Packet& operator>>(sf::Packet& packet, JoinPacket& joinPacket)
 }
 
 /**
- * \brief JoinAckPacket is a TCP Packet that is sent by the server to the client to answer a join packet
+ * \brief JoinAckPacket is a reliable Packet that is sent by the server to the client to answer a join packet
  */
 struct JoinAckPacket : TypedPacket<PacketType::JOIN_ACK>
 {
@@ -125,7 +133,7 @@ inline sf::Packet& operator>>(sf::Packet& packet, JoinAckPacket& joinPacket)
 }
 
 /**
- * \brief SpawnPlayerPacket is a TCP Packet sent by the server to all clients to notify of the spawn of a new player
+ * \brief SpawnPlayerPacket is a reliable Packet sent by the server to all clients to notify of the spawn of a new player
  */
 struct SpawnPlayerPacket : TypedPacket<PacketType::SPAWN_PLAYER>
 {
@@ -156,49 +164,181 @@ struct PlayerInputPacket : TypedPacket<PacketType::INPUT>
 {
     PlayerNumber playerNumber = INVALID_PLAYER;
     std::array<std::uint8_t, sizeof(Frame)> currentFrame{};
+    /**
+     * \brief inputNmb is the number of inputs sent, inputs[i] being the input of currentFrame - i.
+     */
+    std::uint8_t inputNmb = 0;
     std::array<std::uint8_t, MAX_INPUT_NMB> inputs{};
 };
 
+/**
+ * \brief INPUT_RUN_FLAG is set on an encoded input when the next byte is the length of its run.
+ * Player inputs only use the 6 lower bits, so the flag never collides with an input.
+ */
+constexpr std::uint8_t INPUT_RUN_FLAG = 1u << 7u;
+static_assert(MAX_INPUT_NMB <= std::numeric_limits<std::uint8_t>::max(), "The input count and run lengths are sent on one byte");
+
+/**
+ * \brief The inputs of a PlayerInputPacket are run-length encoded, as a player keeps the same input for many frames.
+ * A single input is one byte, a run of the same input is the input with INPUT_RUN_FLAG followed by the run length.
+ */
 inline sf::Packet& operator<<(sf::Packet& packet, const PlayerInputPacket& playerInputPacket)
 {
-    return packet << playerInputPacket.playerNumber <<
-        playerInputPacket.currentFrame << playerInputPacket.inputs;
+    packet << playerInputPacket.playerNumber << playerInputPacket.currentFrame << playerInputPacket.inputNmb;
+    const std::size_t inputNmb = std::min<std::size_t>(playerInputPacket.inputNmb, MAX_INPUT_NMB);
+    std::size_t i = 0;
+    while (i < inputNmb)
+    {
+        const std::uint8_t input = playerInputPacket.inputs[i];
+        gpr_assert((input & INPUT_RUN_FLAG) == 0, "Player input uses the run flag bit");
+        std::uint8_t runLength = 1;
+        while (i + runLength < inputNmb && playerInputPacket.inputs[i + runLength] == input)
+        {
+            runLength++;
+        }
+        if (runLength == 1)
+        {
+            packet << input;
+        }
+        else
+        {
+            packet << static_cast<std::uint8_t>(input | INPUT_RUN_FLAG) << runLength;
+        }
+        i += runLength;
+    }
+    return packet;
 }
 
 inline sf::Packet& operator>>(sf::Packet& packet, PlayerInputPacket& playerInputPacket)
 {
-    return packet >> playerInputPacket.playerNumber >>
-        playerInputPacket.currentFrame >> playerInputPacket.inputs;
+    packet >> playerInputPacket.playerNumber >> playerInputPacket.currentFrame >> playerInputPacket.inputNmb;
+    //A corrupted count or run must not write outside of the inputs
+    playerInputPacket.inputNmb = static_cast<std::uint8_t>(
+        std::min<std::size_t>(playerInputPacket.inputNmb, MAX_INPUT_NMB));
+    std::size_t i = 0;
+    while (i < playerInputPacket.inputNmb && packet)
+    {
+        std::uint8_t input = 0;
+        std::uint8_t runLength = 1;
+        packet >> input;
+        if (input & INPUT_RUN_FLAG)
+        {
+            input &= static_cast<std::uint8_t>(~INPUT_RUN_FLAG);
+            packet >> runLength;
+        }
+        const auto runEnd = std::min<std::size_t>(i + runLength, playerInputPacket.inputNmb);
+        for (; i < runEnd; i++)
+        {
+            playerInputPacket.inputs[i] = input;
+        }
+    }
+    if (i < playerInputPacket.inputNmb)
+    {
+        playerInputPacket.inputNmb = static_cast<std::uint8_t>(i);
+    }
+    return packet;
+}
+
+/**
+ * \brief MultiInputPacket is an UDP Packet sent by the server once per input broadcast period,
+ * with the PlayerInputPacket of every player that sent new inputs during the period.
+ */
+struct MultiInputPacket : TypedPacket<PacketType::MULTI_INPUT>
+{
+    std::uint8_t playerInputNmb = 0;
+    std::array<PlayerInputPacket, MAX_PLAYER_NMB> playerInputs{};
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const MultiInputPacket& multiInputPacket)
+{
+    const std::size_t playerInputNmb = std::min<std::size_t>(multiInputPacket.playerInputNmb, MAX_PLAYER_NMB);
+    packet << static_cast<std::uint8_t>(playerInputNmb);
+    for (std::size_t i = 0; i < playerInputNmb; i++)
+    {
+        packet << multiInputPacket.playerInputs[i];
+    }
+    return packet;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, MultiInputPacket& multiInputPacket)
+{
+    packet >> multiInputPacket.playerInputNmb;
+    multiInputPacket.playerInputNmb = static_cast<std::uint8_t>(
+        std::min<std::size_t>(multiInputPacket.playerInputNmb, MAX_PLAYER_NMB));
+    for (std::size_t i = 0; i < multiInputPacket.playerInputNmb; i++)
+    {
+        packet >> multiInputPacket.playerInputs[i];
+    }
+    return packet;
 }
 
 /**
- * \brief StartGamePacket is a TCP Packet send by the server to start a game at a given time.
+ * \brief StartGamePacket is a reliable Packet send by the server to start a game at a given time.
  */
 struct StartGamePacket : TypedPacket<PacketType::START_GAME>
 {
+    /**
+     * \brief playerNmb is the number of players of the game, chosen by the server.
+     */
+    PlayerNumber playerNmb = DEFAULT_PLAYER_NMB;
 };
 
+inline sf::Packet& operator<<(sf::Packet& packet, const StartGamePacket& startGamePacket)
+{
+    return packet << startGamePacket.playerNmb;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, StartGamePacket& startGamePacket)
+{
+    packet >> startGamePacket.playerNmb;
+    startGamePacket.playerNmb = static_cast<PlayerNumber>(
+        std::clamp<std::uint32_t>(startGamePacket.playerNmb, 1, MAX_PLAYER_NMB));
+    return packet;
+}
+
 /**
  * \brief ValidateFramePacket is an UDP packet that is sent by the server to validate the last physics state of the world.
  */
 struct ValidateFramePacket : TypedPacket<PacketType::VALIDATE_STATE>
 {
     std::array<std::uint8_t, sizeof(Frame)> newValidateFrame{};
-    std::array<std::uint8_t, sizeof(PhysicsState) * MAX_PLAYER_NMB> physicsState{};
+    std::array<std::uint8_t, sizeof(PhysicsState)> physicsState{};
+    /**
+     * \brief inputAckFrames acknowledges the inputs of each player: the first frame whose input the server is missing.
+     * Only the inputAckNmb first ones, one per player of the game, are sent.
+     */
+    std::array<std::array<std::uint8_t, sizeof(Frame)>, MAX_PLAYER_NMB> inputAckFrames{};
+    std::uint8_t inputAckNmb = 0;
 };
 
 inline sf::Packet& operator<<(sf::Packet& packet, const ValidateFramePacket& validateFramePacket)
 {
-    return packet << validateFramePacket.newValidateFrame << validateFramePacket.physicsState;
+    const std::size_t inputAckNmb = std::min<std::size_t>(validateFramePacket.inputAckNmb, MAX_PLAYER_NMB);
+    packet << validateFramePacket.newValidateFrame << validateFramePacket.physicsState <<
+        static_cast<std::uint8_t>(inputAckNmb);
+    for (std::size_t i = 0; i < inputAckNmb; i++)
+    {
+        packet << validateFramePacket.inputAckFrames[i];
+    }
+    return packet;
 }
 
 inline sf::Packet& operator>>(sf::Packet& packet, ValidateFramePacket& ValidateFramePacket)
 {
-    return packet >> ValidateFramePacket.newValidateFrame >> ValidateFramePacket.physicsState;
+    packet >> ValidateFramePacket.newValidateFrame >> ValidateFramePacket.physicsState >>
+        ValidateFramePacket.inputAckNmb;
+    ValidateFramePacket.inputAckNmb = static_cast<std::uint8_t>(
+        std::min<std::size_t>(ValidateFramePacket.inputAckNmb, MAX_PLAYER_NMB));
+    for (std::size_t i = 0; i < ValidateFramePacket.inputAckNmb; i++)
+    {
+        packet >> ValidateFramePacket.inputAckFrames[i];
+    }
+    return packet;
 }
 
 /**
- * \brief WinGamePacket is a TCP Packet sent by the server to notify the clients that a certain player has won.
+ * \brief WinGamePacket is a reliable Packet sent by the server to notify the clients that a certain player has won.
+ * The winner is DRAW_PLAYER when nobody is left in the stage, and INVALID_PLAYER when the server closes the game.
  */
 struct WinGamePacket : TypedPacket<PacketType::WIN_GAME>
 {
@@ -216,7 +356,7 @@ inline sf::Packet& operator>>(sf::Packet& packet, WinGamePacket& winGamePacket)
 }
 
 /**
- * \brief PingPacket is an UDP Packet sent by the client to the server and resend by the server to measure the RTT between the client and the server.
+ * \brief PingPacket is an unreliable Packet sent by the client to the server and resend by the server to measure the RTT between the client and the server.
  */
 struct PingPacket : TypedPacket<PacketType::PING>
 {
@@ -234,7 +374,165 @@ inline sf::Packet& operator>>(sf::Packet& packet, PingPacket& pingPacket)
     return packet >> pingPacket.time >> pingPacket.clientId;
 }
 
-inline std::unique_ptr<Packet> GenerateReceivedPacket(sf::Packet& packet)
+/**
+ * \brief SpectatePacket is a reliable Packet sent by a spectator client to subscribe to a game.
+ * It is the first packet of its connection, instead of a JoinPacket.
+ */
+struct SpectatePacket : TypedPacket<PacketType::SPECTATE>
+{
+    std::array<std::uint8_t, sizeof(ClientId)> clientId{};
+    /**
+     * \brief matchId is the match to watch on a MatchServer, INVALID_MATCH_ID for the last opened one.
+     * A NetworkServer hosts only one game and ignores it.
+     */
+    std::array<std::uint8_t, sizeof(MatchId)> matchId{};
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const SpectatePacket& spectatePacket)
+{
+    return packet << spectatePacket.clientId << spectatePacket.matchId;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, SpectatePacket& spectatePacket)
+{
+    return packet >> spectatePacket.clientId >> spectatePacket.matchId;
+}
+
+/**
+ * \brief SpectateStartPacket is a reliable Packet sent by the server to a spectator when the game it watches has started,
+ * with the spawns of the players, so that the spectator simulates the same world.
+ */
+struct SpectateStartPacket : TypedPacket<PacketType::SPECTATE_START>
+{
+    PlayerNumber playerNmb = 0;
+    std::array<std::array<std::uint8_t, sizeof(core::Vec2f)>, MAX_PLAYER_NMB> positions{};
+    std::array<std::array<std::uint8_t, sizeof(core::Degree)>, MAX_PLAYER_NMB> angles{};
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const SpectateStartPacket& spectateStartPacket)
+{
+    const std::size_t playerNmb = std::min<std::size_t>(spectateStartPacket.playerNmb, MAX_PLAYER_NMB);
+    packet << static_cast<PlayerNumber>(playerNmb);
+    for (std::size_t i = 0; i < playerNmb; i++)
+    {
+        packet << spectateStartPacket.positions[i] << spectateStartPacket.angles[i];
+    }
+    return packet;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, SpectateStartPacket& spectateStartPacket)
+{
+    packet >> spectateStartPacket.playerNmb;
+    spectateStartPacket.playerNmb = static_cast<PlayerNumber>(
+        std::min<std::size_t>(spectateStartPacket.playerNmb, MAX_PLAYER_NMB));
+    for (std::size_t i = 0; i < spectateStartPacket.playerNmb; i++)
+    {
+        packet >> spectateStartPacket.positions[i] >> spectateStartPacket.angles[i];
+    }
+    return packet;
+}
+
+/**
+ * \brief SpectatorInputPacket is an UDP Packet sent by the server to the spectators with the validated inputs
+ * of all the players. Every PlayerInputPacket has the same currentFrame and inputNmb.
+ * physicsState is the validated physics state of stateFrame, the last validated frame of the server
+ * up to currentFrame, to check that the spectator does not desync.
+ */
+struct SpectatorInputPacket : TypedPacket<PacketType::SPECTATOR_INPUT>
+{
+    std::array<std::uint8_t, sizeof(Frame)> stateFrame{};
+    std::array<std::uint8_t, sizeof(PhysicsState)> physicsState{};
+    std::uint8_t playerInputNmb = 0;
+    std::array<PlayerInputPacket, MAX_PLAYER_NMB> playerInputs{};
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const SpectatorInputPacket& spectatorInputPacket)
+{
+    const std::size_t playerInputNmb = std::min<std::size_t>(spectatorInputPacket.playerInputNmb, MAX_PLAYER_NMB);
+    packet << spectatorInputPacket.stateFrame << spectatorInputPacket.physicsState <<
+        static_cast<std::uint8_t>(playerInputNmb);
+    for (std::size_t i = 0; i < playerInputNmb; i++)
+    {
+        packet << spectatorInputPacket.playerInputs[i];
+    }
+    return packet;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, SpectatorInputPacket& spectatorInputPacket)
+{
+    packet >> spectatorInputPacket.stateFrame >> spectatorInputPacket.physicsState >>
+        spectatorInputPacket.playerInputNmb;
+    spectatorInputPacket.playerInputNmb = static_cast<std::uint8_t>(
+        std::min<std::size_t>(spectatorInputPacket.playerInputNmb, MAX_PLAYER_NMB));
+    for (std::size_t i = 0; i < spectatorInputPacket.playerInputNmb; i++)
+    {
+        packet >> spectatorInputPacket.playerInputs[i];
+    }
+    return packet;
+}
+
+/**
+ * \brief SpectatorAckPacket is an UDP Packet sent periodically by a spectator with the first frame it misses.
+ * It also keeps its connection alive.
+ */
+struct SpectatorAckPacket : TypedPacket<PacketType::SPECTATOR_ACK>
+{
+    std::array<std::uint8_t, sizeof(Frame)> nextFrame{};
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const SpectatorAckPacket& spectatorAckPacket)
+{
+    return packet << spectatorAckPacket.nextFrame;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, SpectatorAckPacket& spectatorAckPacket)
+{
+    return packet >> spectatorAckPacket.nextFrame;
+}
+
+/**
+ * \brief PacketVariant holds any packet by value, so that received and queued packets need no heap allocation.
+ */
+using PacketVariant = std::variant<JoinPacket, SpawnPlayerPacket, PlayerInputPacket, ValidateFramePacket,
+    StartGamePacket, JoinAckPacket, WinGamePacket, PingPacket, MultiInputPacket, SpectatePacket, SpectateStartPacket,
+    SpectatorInputPacket, SpectatorAckPacket>;
+
+inline const Packet& GetPacket(const PacketVariant& packetVariant)
+{
+    return std::visit([](const auto& packet) -> const Packet& { return packet; }, packetVariant);
+}
+
+/**
+ * \brief ToPacketVariant copies a packet given by its base class into a PacketVariant.
+ */
+inline PacketVariant ToPacketVariant(const Packet& packet)
+{
+    switch (packet.packetType)
+    {
+    case PacketType::JOIN: return static_cast<const JoinPacket&>(packet);
+    case PacketType::SPAWN_PLAYER: return static_cast<const SpawnPlayerPacket&>(packet);
+    case PacketType::INPUT: return static_cast<const PlayerInputPacket&>(packet);
+    case PacketType::VALIDATE_STATE: return static_cast<const ValidateFramePacket&>(packet);
+    case PacketType::START_GAME: return static_cast<const StartGamePacket&>(packet);
+    case PacketType::JOIN_ACK: return static_cast<const JoinAckPacket&>(packet);
+    case PacketType::WIN_GAME: return static_cast<const WinGamePacket&>(packet);
+    case PacketType::PING: return static_cast<const PingPacket&>(packet);
+    case PacketType::MULTI_INPUT: return static_cast<const MultiInputPacket&>(packet);
+    case PacketType::SPECTATE: return static_cast<const SpectatePacket&>(packet);
+    case PacketType::SPECTATE_START: return static_cast<const SpectateStartPacket&>(packet);
+    case PacketType::SPECTATOR_INPUT: return static_cast<const SpectatorInputPacket&>(packet);
+    case PacketType::SPECTATOR_ACK: return static_cast<const SpectatorAckPacket&>(packet);
+    default:
+        gpr_assert(false, "Unknown packet type");
+        return StartGamePacket{};
+    }
+}
+
+/**
+ * \brief GenerateReceivedPacket is a function that reads a packet from its serialized form.
+ * \return the packet, or nothing if its type is unknown
+ */
+inline std::optional<PacketVariant> GenerateReceivedPacket(sf::Packet& packet)
 {
     Packet packetTmp;
     packet >> packetTmp;
@@ -242,114 +540,172 @@ inline std::unique_ptr<Packet> GenerateReceivedPacket(sf::Packet& packet)
     {
     case PacketType::JOIN:
     {
-        auto joinPacket = std::make_unique<JoinPacket>();
-        joinPacket->packetType = packetTmp.packetType;
-        packet >> *joinPacket;
+        JoinPacket joinPacket;
+        packet >> joinPacket;
         return joinPacket;
     }
     case PacketType::SPAWN_PLAYER:
     {
-        auto spawnPlayerPacket = std::make_unique<SpawnPlayerPacket>();
-        spawnPlayerPacket->packetType = packetTmp.packetType;
-        packet >> *spawnPlayerPacket;
+        SpawnPlayerPacket spawnPlayerPacket;
+        packet >> spawnPlayerPacket;
         return spawnPlayerPacket;
     }
     case PacketType::INPUT:
     {
-        auto playerInputPacket = std::make_unique<PlayerInputPacket>();
-        playerInputPacket->packetType = packetTmp.packetType;
-        packet >> *playerInputPacket;
-
+        PlayerInputPacket playerInputPacket;
+        packet >> playerInputPacket;
         return playerInputPacket;
     }
     case PacketType::VALIDATE_STATE:
     {
-        auto validateFramePacket = std::make_unique<ValidateFramePacket>();
-        validateFramePacket->packetType = packetTmp.packetType;
-        packet >> *validateFramePacket;
+        ValidateFramePacket validateFramePacket;
+        packet >> validateFramePacket;
         return validateFramePacket;
     }
     case PacketType::START_GAME:
     {
-        auto startGamePacket = std::make_unique<StartGamePacket>();
-        startGamePacket->packetType = packetTmp.packetType;
+        StartGamePacket startGamePacket;
+        packet >> startGamePacket;
         return startGamePacket;
     }
     case PacketType::JOIN_ACK:
     {
-        auto joinAckPacket = std::make_unique<JoinAckPacket>();
-        joinAckPacket->packetType = packetTmp.packetType;
-        packet >> *joinAckPacket;
+        JoinAckPacket joinAckPacket;
+        packet >> joinAckPacket;
         return joinAckPacket;
     }
     case PacketType::WIN_GAME:
     {
-        auto winGamePacket = std::make_unique<WinGamePacket>();
-        winGamePacket->packetType = packetTmp.packetType;
-        packet >> *winGamePacket;
+        WinGamePacket winGamePacket;
+        packet >> winGamePacket;
         return winGamePacket;
     }
     case PacketType::PING:
     {
-        auto pingPacket = std::make_unique<PingPacket>();
-        pingPacket->packetType = packetTmp.packetType;
-        packet >> *pingPacket;
+        PingPacket pingPacket;
+        packet >> pingPacket;
         return pingPacket;
     }
+    case PacketType::MULTI_INPUT:
+    {
+        MultiInputPacket multiInputPacket;
+        packet >> multiInputPacket;
+        return multiInputPacket;
+    }
+    case PacketType::SPECTATE:
+    {
+        SpectatePacket spectatePacket;
+        packet >> spectatePacket;
+        return spectatePacket;
+    }
+    case PacketType::SPECTATE_START:
+    {
+        SpectateStartPacket spectateStartPacket;
+        packet >> spectateStartPacket;
+        return spectateStartPacket;
+    }
+    case PacketType::SPECTATOR_INPUT:
+    {
+        SpectatorInputPacket spectatorInputPacket;
+        packet >> spectatorInputPacket;
+        return spectatorInputPacket;
+    }
+    case PacketType::SPECTATOR_ACK:
+    {
+        SpectatorAckPacket spectatorAckPacket;
+        packet >> spectatorAckPacket;
+        return spectatorAckPacket;
+    }
     default:;
     }
-    return nullptr;
+    return std::nullopt;
 }
 
-inline void GeneratePacket(sf::Packet& packet, Packet& sendingPacket)
+/**
+ * \brief GeneratePacket is a function that appends the serialized sendingPacket to packet.
+ * Clearing and reusing the same sf::Packet keeps its buffer, and avoids an allocation per packet.
+ */
+inline void GeneratePacket(sf::Packet& packet, const Packet& sendingPacket)
 {
     packet << sendingPacket;
     switch (sendingPacket.packetType)
     {
     case PacketType::JOIN:
     {
-        const auto& packetTmp = static_cast<JoinPacket&>(sendingPacket);
+        const auto& packetTmp = static_cast<const JoinPacket&>(sendingPacket);
         packet << packetTmp;
         break;
     }
     case PacketType::SPAWN_PLAYER:
     {
-        const auto& packetTmp = static_cast<SpawnPlayerPacket&>(sendingPacket);
+        const auto& packetTmp = static_cast<const SpawnPlayerPacket&>(sendingPacket);
         packet << packetTmp;
         break;
     }
     case PacketType::INPUT:
     {
-        const auto& packetTmp = static_cast<PlayerInputPacket&>(sendingPacket);
+        const auto& packetTmp = static_cast<const PlayerInputPacket&>(sendingPacket);
         packet << packetTmp;
 
         break;
     }
     case PacketType::VALIDATE_STATE:
     {
-        const auto& packetTmp = static_cast<ValidateFramePacket&>(sendingPacket);
+        const auto& packetTmp = static_cast<const ValidateFramePacket&>(sendingPacket);
         packet << packetTmp;
         break;
     }
     case PacketType::START_GAME:
     {
+        const auto& packetTmp = static_cast<const StartGamePacket&>(sendingPacket);
+        packet << packetTmp;
         break;
     }
     case PacketType::JOIN_ACK:
     {
-        const auto& packetTmp = static_cast<JoinAckPacket&>(sendingPacket);
+        const auto& packetTmp = static_cast<const JoinAckPacket&>(sendingPacket);
         packet << packetTmp;
         break;
     }
     case PacketType::WIN_GAME:
     {
-        const auto& packetTmp = static_cast<WinGamePacket&>(sendingPacket);
+        const auto& packetTmp = static_cast<const WinGamePacket&>(sendingPacket);
         packet << packetTmp;
         break;
     }
     case PacketType::PING:
     {
-        const auto& packetTmp = static_cast<PingPacket&>(sendingPacket);
+        const auto& packetTmp = static_cast<const PingPacket&>(sendingPacket);
+        packet << packetTmp;
+        break;
+    }
+    case PacketType::MULTI_INPUT:
+    {
+        const auto& packetTmp = static_cast<const MultiInputPacket&>(sendingPacket);
+        packet << packetTmp;
+        break;
+    }
+    case PacketType::SPECTATE:
+    {
+        const auto& packetTmp = static_cast<const SpectatePacket&>(sendingPacket);
+        packet << packetTmp;
+        break;
+    }
+    case PacketType::SPECTATE_START:
+    {
+        const auto& packetTmp = static_cast<const SpectateStartPacket&>(sendingPacket);
+        packet << packetTmp;
+        break;
+    }
+    case PacketType::SPECTATOR_INPUT:
+    {
+        const auto& packetTmp = static_cast<const SpectatorInputPacket&>(sendingPacket);
+        packet << packetTmp;
+        break;
+    }
+    case PacketType::SPECTATOR_ACK:
+    {
+        const auto& packetTmp = static_cast<const SpectatorAckPacket&>(sendingPacket);
         packet << packetTmp;
         break;
     }
@@ -367,7 +723,7 @@ class PacketSenderInterface
 {
 public:
     virtual ~PacketSenderInterface() = default;
-    virtual void SendReliablePacket(std::unique_ptr<Packet> packet) = 0;
-    virtual void SendUnreliablePacket(std::unique_ptr<Packet> packet) = 0;
+    virtual void SendReliablePacket(const Packet& packet) = 0;
+    virtual void SendUnreliablePacket(const Packet& packet) = 0;
 };
 }
@@ -0,0 +1,202 @@
+#pragma once
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "packet_type.h"
+
+namespace game
+{
+/**
+ * \brief DatagramType is the first byte of every UDP datagram, it tells how the rest of the datagram is read.
+ */
+enum class DatagramType : std::uint8_t
+{
+    UNRELIABLE = 0,
+    RELIABLE,
+    ACK
+};
+
+using ReliableSequence = std::uint16_t;
+
+/**
+ * \brief RELIABLE_RESEND_PERIOD is the time in seconds after which an unacknowledged reliable datagram is sent again.
+ */
+constexpr float RELIABLE_RESEND_PERIOD = 0.1f;
+/**
+ * \brief RELIABLE_WINDOW is how far ahead of the next expected sequence a reliable datagram is kept to be delivered in order.
+ */
+constexpr ReliableSequence RELIABLE_WINDOW = 256;
+/**
+ * \brief CONNECTION_TIMEOUT is the time in seconds without any datagram after which the remote peer is considered disconnected.
+ * Connected clients send a ping packet every few hundred milliseconds, even when the game is not started.
+ */
+constexpr float CONNECTION_TIMEOUT = 5.0f;
+
+/**
+ * \brief GenerateUnreliableDatagram is a function that appends the datagram of an unreliable packet to datagram.
+ */
+void GenerateUnreliableDatagram(sf::Packet& datagram, const Packet& packet);
+
+/**
+ * \brief ReliableChannel is the connection to one remote peer over UDP.
+ * Reliable packets get a sequence number, are sent again until the peer acknowledges them, and are delivered in order.
+ * The acknowledgement is cumulative: the next sequence the peer expects.
+ * Unreliable packets go through the same datagrams, with their own DatagramType and no sequence.
+ */
+class ReliableChannel
+{
+public:
+    /**
+     * \brief Send is a method that queues a reliable packet. It is sent by the next Update, and again until acknowledged.
+     */
+    void Send(const Packet& packet);
+    /**
+     * \brief Send is a method that queues a reliable packet already serialized with GeneratePacket.
+     */
+    void Send(const sf::Packet& packet);
+
+    /**
+     * \brief ReceiveDatagram is a method that reads a datagram coming from the remote peer.
+     * The unreliable packet, or the reliable packets that are now in order, are given to onPacket as a sf::Packet.
+     * \return false when the datagram is malformed
+     */
+    template<typename OnPacket>
+    bool ReceiveDatagram(const char* data, std::size_t size, OnPacket&& onPacket);
+
+    /**
+     * \brief Update is a method that gives to send the datagrams to send now: the pending acknowledgement,
+     * the new reliable datagrams and the ones that were not acknowledged in time.
+     * \param send is called with the data and size of each datagram
+     */
+    template<typename SendDatagram>
+    void Update(sf::Time dt, SendDatagram&& send);
+
+    [[nodiscard]] bool IsTimedOut() const { return timeSinceLastReceive_ > CONNECTION_TIMEOUT; }
+    /**
+     * \brief IsAcknowledged is a method that returns true when the peer acknowledged every reliable packet sent.
+     */
+    [[nodiscard]] bool IsAcknowledged() const { return sentDatagrams_.empty(); }
+
+    /**
+     * \brief IsConnectionDatagram is a function that returns true for the first reliable datagram of a peer,
+     * the only one that opens a new connection.
+     */
+    static bool IsConnectionDatagram(const char* data, std::size_t size);
+
+private:
+    struct SentDatagram
+    {
+        ReliableSequence sequence = 0;
+        std::vector<char> data;
+        float lastSendTime = 0.0f;
+        bool isSent = false;
+    };
+
+    void Acknowledge(ReliableSequence nextSequence);
+    void BufferReliable(ReliableSequence sequence, const char* data, std::size_t size);
+    static ReliableSequence ReadSequence(const char* data);
+
+    //Unacknowledged reliable datagrams, ordered by sequence
+    std::deque<SentDatagram> sentDatagrams_;
+    //Reliable bodies received ahead of the next expected sequence
+    std::unordered_map<ReliableSequence, std::vector<char>> receivedBodies_;
+    //Reused for every delivered packet, sf::Packet keeps its buffer when cleared
+    sf::Packet receivedPacket_;
+    sf::Packet sendingPacket_;
+    float time_ = 0.0f;
+    float timeSinceLastReceive_ = 0.0f;
+    ReliableSequence nextSendSequence_ = 0;
+    ReliableSequence nextReceiveSequence_ = 0;
+    bool isAckPending_ = false;
+};
+
+template<typename OnPacket>
+bool ReliableChannel::ReceiveDatagram(const char* data, std::size_t size, OnPacket&& onPacket)
+{
+    constexpr std::size_t sequencedHeaderSize = 1 + sizeof(ReliableSequence);
+    if (size == 0)
+    {
+        return false;
+    }
+    switch (static_cast<DatagramType>(data[0]))
+    {
+    case DatagramType::UNRELIABLE:
+        timeSinceLastReceive_ = 0.0f;
+        receivedPacket_.clear();
+        receivedPacket_.append(data + 1, size - 1);
+        onPacket(receivedPacket_);
+        return true;
+    case DatagramType::RELIABLE:
+    {
+        if (size < sequencedHeaderSize)
+        {
+            return false;
+        }
+        timeSinceLastReceive_ = 0.0f;
+        //Duplicates are acknowledged too, the previous acknowledgement may have been lost
+        isAckPending_ = true;
+        const auto sequence = ReadSequence(data + 1);
+        if (sequence != nextReceiveSequence_)
+        {
+            BufferReliable(sequence, data + sequencedHeaderSize, size - sequencedHeaderSize);
+            return true;
+        }
+        nextReceiveSequence_++;
+        receivedPacket_.clear();
+        receivedPacket_.append(data + sequencedHeaderSize, size - sequencedHeaderSize);
+        onPacket(receivedPacket_);
+        //The next ones may have arrived before this one
+        for (auto bodyIt = receivedBodies_.find(nextReceiveSequence_); bodyIt != receivedBodies_.end();
+            bodyIt = receivedBodies_.find(nextReceiveSequence_))
+        {
+            nextReceiveSequence_++;
+            receivedPacket_.clear();
+            receivedPacket_.append(bodyIt->second.data(), bodyIt->second.size());
+            receivedBodies_.erase(bodyIt);
+            onPacket(receivedPacket_);
+        }
+        return true;
+    }
+    case DatagramType::ACK:
+        if (size < sequencedHeaderSize)
+        {
+            return false;
+        }
+        timeSinceLastReceive_ = 0.0f;
+        Acknowledge(ReadSequence(data + 1));
+        return true;
+    default:
+        return false;
+    }
+}
+
+template<typename SendDatagram>
+void ReliableChannel::Update(sf::Time dt, SendDatagram&& send)
+{
+    time_ += dt.asSeconds();
+    timeSinceLastReceive_ += dt.asSeconds();
+    if (isAckPending_)
+    {
+        const char ack[] = {
+            static_cast<char>(DatagramType::ACK),
+            static_cast<char>(nextReceiveSequence_ >> 8u),
+            static_cast<char>(nextReceiveSequence_ & 0xFFu) };
+        send(ack, sizeof(ack));
+        isAckPending_ = false;
+    }
+    for (auto& sentDatagram : sentDatagrams_)
+    {
+        if (!sentDatagram.isSent || time_ - sentDatagram.lastSendTime >= RELIABLE_RESEND_PERIOD)
+        {
+            send(sentDatagram.data.data(), sentDatagram.data.size());
+            sentDatagram.lastSendTime = time_;
+            sentDatagram.isSent = true;
+        }
+    }
+}
+}
@@ -1,10 +1,15 @@
 #pragma once
+#include <bitset>
 #include <memory>
+#include <string>
+#include <string_view>
 
 #include "packet_type.h"
 #include "engine/system.h"
 #include "game/game_globals.h"
 #include "game/game_manager.h"
+#include "game/replay.h"
+#include "network/spectator_relay.h"
 
 namespace game
 {
@@ -13,6 +18,30 @@ namespace game
  */
 class Server : public PacketSenderInterface, public core::SystemInterface
 {
+public:
+    /**
+     * \brief SetInputBroadcastPeriod is a method that sets how the received inputs are sent back to the clients.
+     * With a period of 0, each PlayerInputPacket is echoed as soon as it arrives, for the lowest latency.
+     * Otherwise the new inputs of all the players are sent together in one MultiInputPacket per period,
+     * which adds up to one period of latency but sends one packet per period instead of one per received packet.
+     * \param period in seconds
+     */
+    void SetInputBroadcastPeriod(float period) { inputBroadcastPeriod_ = period; }
+    /**
+     * \brief SetPlayerNmb is a method that sets the number of players of the game, before they join.
+     * The game starts when they all joined.
+     */
+    void SetPlayerNmb(PlayerNumber playerNmb) { gameManager_.SetPlayerNmb(playerNmb); }
+    [[nodiscard]] PlayerNumber GetPlayerNmb() const { return gameManager_.GetPlayerNmb(); }
+    /**
+     * \brief GetWinner is a method that returns the winner declared by the server, INVALID_PLAYER while the game goes on.
+     */
+    [[nodiscard]] PlayerNumber GetWinner() const { return gameManager_.GetWinner(); }
+    /**
+     * \brief SetReplayPath is a method that makes the server record the confirmed inputs of the game in a replay file.
+     * It needs to be called before the game starts. \see ReplayWriter
+     */
+    void SetReplayPath(std::string_view path) { replayPath_ = path; }
 protected:
     Server() : gameManager_(){}
 
@@ -21,12 +50,37 @@ protected:
      * \brief ReceiveNetPacket is a method that is called when the Server receives a Packet from a Client.
      * \param packet is the received Packet.
      */
-    virtual void ReceivePacket(std::unique_ptr<Packet> packet);
+    virtual void ReceivePacket(const Packet& packet);
+    /**
+     * \brief UpdateInputBroadcast is a method that sends the MultiInputPacket when the input broadcast period is over.
+     * It is called by the Update of the servers, after they received their packets.
+     */
+    void UpdateInputBroadcast(float dt);
+    [[nodiscard]] bool HasPendingInputs() const { return pendingInputPlayers_.any(); }
 
     //Server game manager
     GameManager gameManager_;
     PlayerNumber lastPlayerNumber_ = 0;
     std::array<ClientId, MAX_PLAYER_NMB> clientMap_{};
+    float inputBroadcastPeriod_ = 0.0f;
+    /**
+     * \brief isSpectated_ is set by the servers that have a SpectatorRelay, they take spectatorFrames_ after each Update.
+     */
+    bool isSpectated_ = false;
+    SpectatorFrames spectatorFrames_;
+
+private:
+    /**
+     * \brief FillInputEcho is a method that puts in inputPacket the confirmed inputs of the player,
+     * from its last received frame back to MAX_INPUT_NMB frames or the first missing one.
+     */
+    void FillInputEcho(PlayerNumber playerNumber, PlayerInputPacket& inputPacket) const;
+
+    std::string replayPath_;
+    ReplayWriter replayWriter_;
+    float inputBroadcastTimer_ = 0.0f;
+    //Players that sent new inputs since the last MultiInputPacket
+    std::bitset<MAX_PLAYER_NMB> pendingInputPlayers_;
 
 };
 }
@@ -29,8 +29,8 @@ public:
 
     void OnEvent(const sf::Event& event) override;
 private:
-    std::array<std::unique_ptr<SimulationClient>, MAX_PLAYER_NMB> clients_;
-    std::array<sf::RenderTexture, MAX_PLAYER_NMB> clientsFramebuffers_;
+    std::array<std::unique_ptr<SimulationClient>, DEFAULT_PLAYER_NMB> clients_;
+    std::array<sf::RenderTexture, DEFAULT_PLAYER_NMB> clientsFramebuffers_;
     SimulationServer server_;
     sf::Sprite screenQuad_;
     sf::Vector2u windowSize_;
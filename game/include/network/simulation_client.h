@@ -24,13 +24,17 @@ public:
     void Draw(sf::RenderTarget& window) override;
 
 
-    void SendUnreliablePacket(std::unique_ptr<Packet> packet) override;
-    void SendReliablePacket(std::unique_ptr<Packet> packet) override;
+    void SendUnreliablePacket(const Packet& packet) override;
+    void SendReliablePacket(const Packet& packet) override;
 
     void ReceivePacket(const Packet* packet) override;
     
     void DrawImGui() override;
     void SetPlayerInput(PlayerInput input);
+    /**
+     * \brief Join is a method that sends the JoinPacket of the client to the server.
+     */
+    void Join();
     
 private:
     SimulationServer& server_;
@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <span>
 #include <SFML/System/Time.hpp>
 
 #include "debug_db.h"
@@ -14,33 +15,45 @@ namespace game
 struct DelayPacket
 {
 	float currentTime = 0.0f;
-	std::unique_ptr<Packet> packet = nullptr;
+	PacketVariant packet;
 };
 class SimulationClient;
 
 /**
  * \brief SimulationServer is a Server that delays Packet internally before "receiving" them and then sends them back with delay to the SimulationClient.
+ * The game has one player per SimulationClient.
  */
 class SimulationServer final : public Server, public core::DrawImGuiInterface
 {
 public:
-	explicit SimulationServer(std::array<std::unique_ptr<SimulationClient>, 2>& clients);
+	explicit SimulationServer(std::span<std::unique_ptr<SimulationClient>> clients);
 	void Begin() override;
 	void Update(sf::Time dt) override;
 	void End() override;
 	void DrawImGui() override;
-	void PutPacketInReceiveQueue(std::unique_ptr<Packet> packet, bool unreliable);
-	void SendReliablePacket(std::unique_ptr<Packet> packet) override;
-	void SendUnreliablePacket(std::unique_ptr<Packet> packet) override;
+	void PutPacketInReceiveQueue(const Packet& packet, bool unreliable);
+	/**
+	 * \brief SetDelay is a method that sets the one way delay of the packets in both directions,
+	 * drawn uniformly between avgDelay - marginDelay and avgDelay + marginDelay.
+	 * \param avgDelay in seconds, half of the round trip time
+	 * \param marginDelay in seconds, the jitter
+	 */
+	void SetDelay(float avgDelay, float marginDelay);
+	/**
+	 * \brief SetPacketLoss is a method that sets the probability to drop an unreliable packet sent by a client.
+	 */
+	void SetPacketLoss(float packetLoss) { packetLoss_ = packetLoss; }
+	void SendReliablePacket(const Packet& packet) override;
+	void SendUnreliablePacket(const Packet& packet) override;
 private:
-	void PutPacketInSendingQueue(std::unique_ptr<Packet> packet);
-	void ProcessReceivePacket(std::unique_ptr<Packet> packet);
+	void PutPacketInSendingQueue(const Packet& packet);
+	void ProcessReceivePacket(const Packet& packet);
 
 	void SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber) override;
 
 	std::vector<DelayPacket> receivedPackets_;
 	std::vector<DelayPacket> sentPackets_;
-	std::array<std::unique_ptr<SimulationClient>, MAX_PLAYER_NMB>& clients_;
+	std::span<std::unique_ptr<SimulationClient>> clients_;
 	float avgDelay_ = 0.02f;
 	float marginDelay_ = 0.01f;
 	float packetLoss_ = 0.0f;
@@ -0,0 +1,22 @@
+#pragma once
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/SocketHandle.hpp>
+
+namespace game
+{
+/**
+ * \brief GetSocketHandle returns the native handle of a SFML socket, that SFML keeps protected.
+ * It is used to register the sockets in epoll and for the batched system calls.
+ */
+inline sf::SocketHandle GetSocketHandle(const sf::Socket& socket)
+{
+    struct SocketHandleAccess : sf::Socket
+    {
+        static sf::SocketHandle GetHandle(const sf::Socket& s)
+        {
+            return (s.*&SocketHandleAccess::getHandle)();
+        }
+    };
+    return SocketHandleAccess::GetHandle(socket);
+}
+}
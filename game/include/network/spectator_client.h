@@ -0,0 +1,70 @@
+#pragma once
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "packet_type.h"
+#include "reliable_channel.h"
+#include "engine/system.h"
+#include "game/game_globals.h"
+#include "game/game_manager.h"
+
+namespace game
+{
+/**
+ * \brief SpectatorClient is a network client that watches a game without playing it.
+ * It subscribes with a SpectatePacket and simulates the validated frames relayed by the server in a GameManager,
+ * without rollback nor rendering, and checks the physics states sent with them.
+ */
+class SpectatorClient final : public core::SystemInterface
+{
+public:
+    void Begin() override;
+
+    void Update(sf::Time dt) override;
+
+    void End() override;
+
+    void SetServerAddress(std::string_view address, unsigned short port);
+    /**
+     * \brief SetMatchId is a method that chooses the match to watch on a MatchServer, before Begin.
+     * By default it is the last opened one.
+     */
+    void SetMatchId(MatchId matchId) { matchId_ = matchId; }
+
+    /**
+     * \brief IsOver is a method that returns true when the game has a winner, was closed by the server, or timed out.
+     */
+    [[nodiscard]] bool IsOver() const { return isOver_; }
+    [[nodiscard]] bool IsStarted() const { return isStarted_; }
+    [[nodiscard]] const GameManager& GetGameManager() const { return gameManager_; }
+    [[nodiscard]] PlayerNumber GetWinner() const { return winner_; }
+    [[nodiscard]] std::size_t GetDesyncNmb() const { return desyncNmb_; }
+private:
+    void ReceiveNetPacket(sf::Packet& packet);
+    void StartGame(const SpectateStartPacket& spectateStartPacket);
+    void ReceiveInputPacket(const SpectatorInputPacket& spectatorInputPacket);
+    void SendDatagram(const char* data, std::size_t size);
+
+    GameManager gameManager_;
+    sf::UdpSocket udpSocket_;
+    ReliableChannel channel_;
+    std::array<char, sf::UdpSocket::MaxDatagramSize> receiveBuffer_{};
+    //Reused for every packet, sf::Packet keeps its buffer when cleared
+    sf::Packet sendingPacket_;
+
+    std::string serverAddress_ = "localhost";
+    unsigned short serverPort_ = 12345;
+    MatchId matchId_ = INVALID_MATCH_ID;
+    ClientId clientId_ = INVALID_CLIENT_ID;
+
+    float ackTimer_ = 0.0f;
+    std::size_t desyncNmb_ = 0;
+    PlayerNumber winner_ = INVALID_PLAYER;
+    bool isStarted_ = false;
+    bool isOver_ = false;
+};
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "datagram_batch.h"
+#include "packet_type.h"
+#include "reliable_channel.h"
+#include "game/game_globals.h"
+#include "game/replay.h"
+
+namespace game
+{
+class GameManager;
+
+/**
+ * \brief MAX_SPECTATOR_NMB is the number of spectators a SpectatorRelay accepts, the next ones are refused.
+ */
+constexpr std::size_t MAX_SPECTATOR_NMB = 1024;
+/**
+ * \brief SPECTATOR_ACK_PERIOD is the time in seconds between two SpectatorAckPacket of a spectator.
+ */
+constexpr float SPECTATOR_ACK_PERIOD = 0.1f;
+/**
+ * \brief SPECTATOR_CATCH_UP_DELAY is the time in seconds without progress after which a spectator that misses frames
+ * gets its own catch-up packets, instead of waiting for the broadcast.
+ */
+constexpr float SPECTATOR_CATCH_UP_DELAY = 0.25f;
+/**
+ * \brief SPECTATOR_CATCH_UP_PACKET_NMB is the number of SpectatorInputPacket, of MAX_INPUT_NMB frames each,
+ * sent at once to a spectator that catches up.
+ */
+constexpr std::size_t SPECTATOR_CATCH_UP_PACKET_NMB = 4;
+
+/**
+ * \brief SpectatorCheckpoint is the validated physics state of a frame, the last one of a validation.
+ */
+struct SpectatorCheckpoint
+{
+    Frame frame = 0;
+    PhysicsState physicsState = 0;
+};
+
+/**
+ * \brief SpectatorFrames is what the server simulation gives to the spectators: the spawns of the players when the game
+ * starts, then the confirmed inputs of the frames validated since the SpectatorRelay took them.
+ * Filling it only copies one input per player and per frame, so it does not slow down the simulation thread.
+ */
+struct SpectatorFrames
+{
+    /**
+     * \brief Start is a method that keeps the spawns of the players, when the game starts.
+     */
+    void Start(const GameManager& gameManager);
+    /**
+     * \brief AddValidatedFrames is a method that adds the inputs of the frames validated since the last call.
+     * It is called by the server after each validation, while the inputs are still in the window.
+     */
+    void AddValidatedFrames(const GameManager& gameManager);
+    /**
+     * \brief Clear is a method that removes the inputs taken by the SpectatorRelay, keeping their buffer.
+     */
+    void Clear();
+
+    bool isStarted = false;
+    PlayerNumber playerNmb = 0;
+    std::array<ReplaySpawn, MAX_PLAYER_NMB> spawns{};
+    Frame firstFrame = 1;
+    Frame lastFrame = 0;
+    /**
+     * \brief inputs has the inputs of all the players of firstFrame, then of the next frame, up to lastFrame.
+     */
+    std::vector<PlayerInput> inputs;
+    std::vector<SpectatorCheckpoint> checkpoints;
+};
+
+/**
+ * \brief SpectatorRelay sends the validated frames of one game to its spectators, on the thread that owns the socket.
+ * It keeps all the validated inputs of the game, so that a spectator can join at any time.
+ * When new frames are validated, one SpectatorInputPacket with the last MAX_INPUT_NMB frames is encoded once
+ * and queued for all the spectators, a lost packet being covered by the next ones.
+ * Only a spectator that stops progressing, because it joined late or lost too many packets, gets its own packets.
+ * Spectators never roll back: they only simulate validated frames.
+ */
+class SpectatorRelay
+{
+public:
+    explicit SpectatorRelay(DatagramBatch& datagramBatch);
+
+    /**
+     * \brief ReceiveConnectionDatagram is a method that adds a spectator if the datagram opens a connection with a SpectatePacket.
+     * \return true if the datagram was a SpectatePacket
+     */
+    bool ReceiveConnectionDatagram(const ReceivedDatagram& datagram);
+    /**
+     * \brief AddSpectator is a method that adds a spectator whose channel already received its SpectatePacket.
+     * \return false if the relay is full
+     */
+    bool AddSpectator(sf::IpAddress address, unsigned short port, ReliableChannel& channel);
+    /**
+     * \brief ReceiveDatagram is a method that reads a datagram of a spectator.
+     * \return false if the datagram does not come from a spectator of this relay
+     */
+    bool ReceiveDatagram(const ReceivedDatagram& datagram);
+    /**
+     * \brief TakeFrames is a method that adds the frames given by the simulation to the ones sent to the spectators,
+     * and clears them.
+     */
+    void TakeFrames(SpectatorFrames& frames);
+    /**
+     * \brief Update is a method that queues the new frames for the spectators, the catch-up packets,
+     * and the datagrams of their channels. It removes the spectators that timed out.
+     */
+    void Update(sf::Time dt);
+    /**
+     * \brief Close is a method that tells the spectators that the game is over, and removes them.
+     */
+    void Close();
+
+    [[nodiscard]] std::size_t GetSpectatorNmb() const { return spectators_.size(); }
+    [[nodiscard]] Frame GetLastFrame() const { return firstFrame_ + GetFrameNmb() - 1; }
+private:
+    struct Spectator
+    {
+        sf::IpAddress address;
+        unsigned short port = 0;
+        ReliableChannel channel;
+        Frame nextFrame = 1;
+        //Time since nextFrame last moved forward
+        float stallTime = 0.0f;
+        bool isStarted = false;
+    };
+
+    [[nodiscard]] Frame GetFrameNmb() const
+    {
+        return playerNmb_ == 0 ? 0 : static_cast<Frame>(inputs_.size() / playerNmb_);
+    }
+    /**
+     * \brief FillInputPacket is a method that puts the inputs of the frames from firstFrame to lastFrame in inputPacket_.
+     */
+    void FillInputPacket(Frame firstFrame, Frame lastFrame);
+    void SendCatchUp(Spectator& spectator);
+    void ReceiveSpectatorPacket(Spectator& spectator, sf::Packet& packet) const;
+    void SendChannelDatagrams(Spectator& spectator, sf::Time dt);
+
+    DatagramBatch& datagramBatch_;
+    std::unordered_map<std::uint64_t, Spectator> spectators_;
+
+    bool isStarted_ = false;
+    PlayerNumber playerNmb_ = 0;
+    Frame firstFrame_ = 1;
+    //All the validated inputs of the game, from firstFrame_
+    std::vector<PlayerInput> inputs_;
+    std::vector<SpectatorCheckpoint> checkpoints_;
+    Frame broadcastFrame_ = 0;
+
+    //Reused for every packet, so that their buffers are only allocated once
+    sf::Packet serializedStartPacket_;
+    SpectatorInputPacket inputPacket_;
+    sf::Packet sendingPacket_;
+};
+}
@@ -0,0 +1,52 @@
+#include <string>
+#include <thread>
+
+#include "network/match_server.h"
+
+int main(int argc, char** argv)
+{
+    unsigned short port = 0;
+    if (argc >= 2)
+    {
+        const std::string portArg = argv[1];
+        port = static_cast<unsigned short>(std::stoi(portArg));
+    }
+    //The main thread receives and sends the packets, it also updates matches with the workers
+    std::size_t workerNmb = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    if (argc >= 3)
+    {
+        const std::string workerArg = argv[2];
+        workerNmb = static_cast<std::size_t>(std::stoi(workerArg));
+    }
+    game::MatchServer server(workerNmb);
+    if (port != 0)
+    {
+        server.SetPort(port);
+    }
+    //Input broadcast period in milliseconds, 0 echoes each input packet as soon as it arrives
+    if (argc >= 4)
+    {
+        const std::string periodArg = argv[3];
+        server.SetInputBroadcastPeriod(static_cast<float>(std::stoi(periodArg)) / 1000.0f);
+    }
+    //Number of players of each match, up to MAX_PLAYER_NMB
+    if (argc >= 5)
+    {
+        const std::string playerNmbArg = argv[4];
+        server.SetPlayerNmb(static_cast<game::PlayerNumber>(std::stoi(playerNmbArg)));
+    }
+    //Folder of the replay files of the matches, played back by the replayer
+    if (argc >= 6)
+    {
+        server.SetReplayFolder(argv[5]);
+    }
+    server.Begin();
+    sf::Clock clock;
+    while (server.IsOpen())
+    {
+        const auto dt = clock.restart();
+        server.Update(dt);
+    }
+    server.End();
+    return 0;
+}
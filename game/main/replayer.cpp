@@ -0,0 +1,92 @@
+#include <chrono>
+#include <string>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "game/game_manager.h"
+#include "game/replay.h"
+
+/**
+ * \brief replayer plays back a replay file recorded by the server as fast as possible, without window.
+ * It checks the physics state of each chunk against the recorded one, to find the frame where a desync starts.
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fmt::print("Usage: replayer <replay file>\n");
+        return 1;
+    }
+    spdlog::set_level(spdlog::level::warn);
+    game::ReplayReader replayReader;
+    if (!replayReader.Open(argv[1]))
+    {
+        return 1;
+    }
+    game::GameManager gameManager;
+    gameManager.SetPlayerNmb(replayReader.GetPlayerNmb());
+    //Spawned in the order of the server, so that the entities are the same
+    for (game::PlayerNumber playerNumber = 0; playerNumber < replayReader.GetPlayerNmb(); playerNumber++)
+    {
+        const auto& spawn = replayReader.GetSpawn(playerNumber);
+        gameManager.SpawnPlayer(playerNumber, spawn.position, spawn.rotation);
+        gameManager.SpawnGloves(playerNumber, spawn.position, spawn.rotation);
+    }
+
+    game::ReplayChunk chunk;
+    std::size_t chunkNmb = 0;
+    std::size_t desyncChunkNmb = 0;
+    const auto replayStart = std::chrono::steady_clock::now();
+    while (replayReader.ReadChunk(chunk))
+    {
+        const auto playerNmb = replayReader.GetPlayerNmb();
+        for (game::Frame frame = chunk.firstFrame; frame <= chunk.lastFrame; frame++)
+        {
+            for (game::PlayerNumber playerNumber = 0; playerNumber < playerNmb; playerNumber++)
+            {
+                gameManager.SetPlayerInput(playerNumber,
+                    chunk.inputs[static_cast<std::size_t>(frame - chunk.firstFrame) * playerNmb + playerNumber], frame);
+            }
+            //The inputs are kept in a window, so a long chunk is validated before it is overwritten
+            if (frame - gameManager.GetLastValidateFrame() >= game::WINDOW_BUFFER_SIZE / 2)
+            {
+                gameManager.Validate(frame);
+            }
+        }
+        gameManager.Validate(chunk.lastFrame);
+        chunkNmb++;
+        const auto physicsState = gameManager.GetRollbackManager().GetValidatePhysicsState();
+        if (physicsState != chunk.physicsState)
+        {
+            if (desyncChunkNmb == 0)
+            {
+                fmt::print("Desync between frames {} and {}: recorded physics state {:016x}, replayed {:016x}\n",
+                    chunk.firstFrame, chunk.lastFrame, chunk.physicsState, physicsState);
+            }
+            desyncChunkNmb++;
+        }
+    }
+    const std::chrono::duration<double> replayDuration = std::chrono::steady_clock::now() - replayStart;
+
+    const auto frameNmb = gameManager.GetLastValidateFrame();
+    fmt::print("Replayed {} frames of {} players in {:.3f} s, {:.0f} frames/s\n",
+        frameNmb, replayReader.GetPlayerNmb(), replayDuration.count(),
+        replayDuration.count() > 0.0 ? frameNmb / replayDuration.count() : 0.0);
+    const auto winner = gameManager.CheckWinner();
+    if (winner == game::DRAW_PLAYER)
+    {
+        fmt::print("Draw\n");
+    }
+    else if (winner != game::INVALID_PLAYER)
+    {
+        fmt::print("P{} won\n", static_cast<unsigned>(winner) + 1);
+    }
+    if (desyncChunkNmb > 0)
+    {
+        fmt::print("{} of {} chunks desynced\n", desyncChunkNmb, chunkNmb);
+        return 2;
+    }
+    fmt::print("All {} chunks match the recorded physics states\n", chunkNmb);
+    return 0;
+}
@@ -5,7 +5,7 @@
 int main(int argc, char** argv)
 {
     unsigned short port = 0;
-    if (argc == 2)
+    if (argc >= 2)
     {
         const std::string portArg = argv[1];
         port = static_cast<unsigned short>(std::stoi(portArg));
@@ -13,7 +13,24 @@ int main(int argc, char** argv)
     game::NetworkServer server;
     if (port != 0)
     {
-        server.SetTcpPort(port);
+        server.SetPort(port);
+    }
+    //Input broadcast period in milliseconds, 0 echoes each input packet as soon as it arrives
+    if (argc >= 3)
+    {
+        const std::string periodArg = argv[2];
+        server.SetInputBroadcastPeriod(static_cast<float>(std::stoi(periodArg)) / 1000.0f);
+    }
+    //Number of players of the game, up to MAX_PLAYER_NMB
+    if (argc >= 4)
+    {
+        const std::string playerNmbArg = argv[3];
+        server.SetPlayerNmb(static_cast<game::PlayerNumber>(std::stoi(playerNmbArg)));
+    }
+    //Replay file of the game, played back by the replayer
+    if (argc >= 5)
+    {
+        server.SetReplayPath(argv[4]);
     }
     server.Begin();
     sf::Clock clock;
@@ -22,5 +39,6 @@ int main(int argc, char** argv)
         const auto dt = clock.restart();
         server.Update(dt);
     }
+    server.End();
     return 0;
 }
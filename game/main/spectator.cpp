@@ -0,0 +1,66 @@
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "network/spectator_client.h"
+
+/**
+ * \brief spectator watches a game of a server or a match server without window.
+ * It simulates the validated frames relayed by the server, and checks them against the server physics states.
+ */
+int main(int argc, char** argv)
+{
+    game::SpectatorClient spectator;
+    std::string address = "localhost";
+    unsigned short port = 12345;
+    if (argc >= 2)
+    {
+        address = argv[1];
+    }
+    if (argc >= 3)
+    {
+        const std::string portArg = argv[2];
+        port = static_cast<unsigned short>(std::stoi(portArg));
+    }
+    spectator.SetServerAddress(address, port);
+    //Match to watch on a match server, the last opened one by default
+    if (argc >= 4)
+    {
+        const std::string matchArg = argv[3];
+        spectator.SetMatchId(static_cast<game::MatchId>(std::stoul(matchArg)));
+    }
+    spectator.Begin();
+    sf::Clock clock;
+    while (!spectator.IsOver())
+    {
+        const auto dt = clock.restart();
+        spectator.Update(dt);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    spectator.End();
+
+    if (!spectator.IsStarted())
+    {
+        fmt::print("The game did not start\n");
+        return 1;
+    }
+    const auto& gameManager = spectator.GetGameManager();
+    fmt::print("Watched {} frames of {} players\n",
+        gameManager.GetLastValidateFrame(), static_cast<unsigned>(gameManager.GetPlayerNmb()));
+    if (spectator.GetWinner() == game::DRAW_PLAYER)
+    {
+        fmt::print("Draw\n");
+    }
+    else if (spectator.GetWinner() != game::INVALID_PLAYER)
+    {
+        fmt::print("P{} won\n", static_cast<unsigned>(spectator.GetWinner()) + 1);
+    }
+    if (spectator.GetDesyncNmb() > 0)
+    {
+        fmt::print("{} physics states desynced\n", spectator.GetDesyncNmb());
+        return 2;
+    }
+    return 0;
+}
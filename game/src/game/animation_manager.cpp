@@ -5,7 +5,7 @@
 namespace game
 {
 AnimationManager::AnimationManager(core::EntityManager& entityManager, core::SpriteManager& spriteManager) :
-	ComponentManager(entityManager), spriteManager_(spriteManager)
+	SparseComponentManager(entityManager), spriteManager_(spriteManager)
 {}
 
 void AnimationManager::SetupComponent(core::Entity entity, Animation& animation)
@@ -56,19 +56,15 @@ void AnimationManager::Init()
 
 void AnimationManager::Update(const sf::Time dt)
 {
-	for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+	RemoveDestroyedEntities();
+	for (std::size_t i = 0; i < packed_.entities.size(); i++)
 	{
+		const core::Entity entity = packed_.entities[i];
 		if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
 		{
 			continue;
 		}
-
-		if (!entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::ANIMATION_DATA)))
-		{
-			continue;
-		}
-
-		auto data = GetComponent(entity);
+		auto& data = packed_.components[i];
 		data.time += dt.asSeconds();
 		const auto& [animTexture, looping] = *data.animation;
 
@@ -93,8 +89,6 @@ void AnimationManager::Update(const sf::Time dt)
 				ANIMATION_PIXEL_SIZE, ANIMATION_PIXEL_SIZE });
 			spriteManager_.SetComponent(entity, sprite);
 		}
-
-		SetComponent(entity, data);
 	}
 }
 }
\ No newline at end of file
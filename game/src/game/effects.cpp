@@ -3,7 +3,7 @@
 #include "game/game_manager.h"
 
 game::EffectManager::EffectManager(core::EntityManager& entityManager, GameManager& gameManager) :
-	ComponentManager(entityManager), gameManager_(gameManager)
+	SparseComponentManager(entityManager), gameManager_(gameManager)
 
 {
 }
@@ -13,22 +13,21 @@ void game::EffectManager::Update(sf::Time dt)
 #ifdef TRACY_ENABLE
 	ZoneScoped;
 #endif
-	for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+	RemoveDestroyedEntities();
+	//DestroyEffect only flags the entity, the dense arrays are not resized during the loop
+	for (std::size_t i = 0; i < packed_.entities.size(); i++)
 	{
+		const core::Entity entity = packed_.entities[i];
 		if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
 		{
 			continue;
 		}
-		if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::EFFECT)))
-		{
-			auto& effect = GetComponent(entity);
-			effect.lifetime -= dt.asSeconds();
+		auto& effect = packed_.components[i];
+		effect.lifetime -= dt.asSeconds();
 
-			SetComponent(entity, effect);
-			if (effect.lifetime < 0.0f)
-			{
-				gameManager_.DestroyEffect(entity);
-			}
+		if (effect.lifetime < 0.0f)
+		{
+			gameManager_.DestroyEffect(entity);
 		}
 	}
 }
\ No newline at end of file
@@ -6,7 +6,9 @@
 #include "utils/conversion.h"
 
 #include <fmt/format.h>
+#ifndef GAME_HEADLESS
 #include <imgui.h>
+#endif
 #include <chrono>
 
 
@@ -58,7 +60,9 @@ void GameManager::SpawnGloves(PlayerNumber playerNumber, core::Vec2f playerPos,
         // Calculate position and rotation
         // Positions are swapped if glove is on the right
         const float sign = gloveNum == 0 ? 1.0f : -1.0f;
-        const auto position = playerPos + core::Vec2f(0, GLOVE_IDEAL_DIST).Rotate(-playerRot).Rotate(GLOVE_IDEAL_ANGLE * sign);
+        // Computed with the simulation types, so that the gloves spawn at the same place on every platform
+        const auto position = ToVec2f(ToVec2(playerPos) +
+            Vec2(0, GLOVE_IDEAL_DIST).Rotate(-ToAngle(playerRot)).Rotate(ToAngle(GLOVE_IDEAL_ANGLE) * sign));
         const auto rotation = playerRot;
 
         transformManager_.AddComponent(entity);
@@ -94,6 +98,12 @@ std::array<core::Entity, 2> GameManager::GetGlovesEntityFromPlayerNumber(PlayerN
     return gloves;
 }
 
+void GameManager::SetPlayerNmb(PlayerNumber playerNmb)
+{
+    gpr_assert(playerNmb > 0 && playerNmb <= MAX_PLAYER_NMB, "Invalid player number of the game");
+    playerNmb_ = playerNmb;
+}
+
 void GameManager::SetPlayerInput(PlayerNumber playerNumber, PlayerInput playerInput, std::uint32_t inputFrame)
 {
     if (playerNumber == INVALID_PLAYER)
@@ -120,33 +130,29 @@ PlayerNumber GameManager::CheckWinner()
     int winningPlayer = 0;
     PlayerNumber winner = INVALID_PLAYER;
     const auto& physicsManager = rollbackManager_.GetCurrentPhysicsManager();
-    const auto& playerManager = rollbackManager_.GetPlayerCharacterManager();
-    for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+    for (PlayerNumber playerNumber = 0; playerNumber < playerNmb_; playerNumber++)
     {
-        if (!entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::PLAYER_CHARACTER)))
+        const auto playerEntity = GetEntityFromPlayerNumber(playerNumber);
+        if (playerEntity == core::INVALID_ENTITY)
             continue;
-        const auto& playerBody = physicsManager.GetBody(entity);
-        const auto& player = playerManager.GetComponent(entity);
+        const auto& playerBody = physicsManager.GetBody(playerEntity);
 
         // Check if player is out of the bounds of the battleStage
-        if (std::abs(playerBody.position.x) > BATTLE_STAGE_WIDTH / 2.0f ||
-            std::abs(playerBody.position.y) > BATTLE_STAGE_HEIGHT / 2.0f)
-        {
-        }
-        else
+        if (core::Abs(playerBody.position.x) <= BATTLE_STAGE_WIDTH / 2.0f &&
+            core::Abs(playerBody.position.y) <= BATTLE_STAGE_HEIGHT / 2.0f)
         {
             winningPlayer++;
-            winner = player.playerNumber;
+            winner = playerNumber;
         }
     }
 
     if (winningPlayer == 0)
     {
-        // If both loses, default to 
-        return 1;
+        // The last players left the stage at the same frame
+        return DRAW_PLAYER;
     }
-
-    return winningPlayer == 1 ? winner : INVALID_PLAYER;
+    // A player alone keeps playing until it leaves the stage
+    return winningPlayer == 1 && playerNmb_ > 1 ? winner : INVALID_PLAYER;
 }
 
 void GameManager::WinGame(PlayerNumber winner)
@@ -154,6 +160,7 @@ void GameManager::WinGame(PlayerNumber winner)
     winner_ = winner;
 }
 
+#ifndef GAME_HEADLESS
 ClientGameManager::ClientGameManager(PacketSenderInterface& packetSenderInterface) :
     GameManager(),
     packetSenderInterface_(packetSenderInterface),
@@ -309,6 +316,17 @@ void ClientGameManager::Draw(sf::RenderTarget& target)
                 static_cast<float>(windowSize_.y) / 2.0f - textBounds.height / 2.0f);
             target.draw(textRenderer_);
         }
+        else if (winner_ == DRAW_PLAYER)
+        {
+            const std::string drawText = fmt::format("Draw!");
+            textRenderer_.setFillColor(sf::Color::White);
+            textRenderer_.setString(drawText);
+            textRenderer_.setCharacterSize(32);
+            const auto textBounds = textRenderer_.getLocalBounds();
+            textRenderer_.setPosition(static_cast<float>(windowSize_.x) / 2.0f - textBounds.width / 2.0f,
+                static_cast<float>(windowSize_.y) / 2.0f - textBounds.height / 2.0f);
+            target.draw(textRenderer_);
+        }
         else if (winner_ != INVALID_PLAYER)
         {
             const std::string winnerText = fmt::format("P{} won!", winner_ + 1);
@@ -357,7 +375,7 @@ void ClientGameManager::Draw(sf::RenderTarget& target)
     {
         std::string percent;
         const auto& playerManager = rollbackManager_.GetPlayerCharacterManager();
-        for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB; playerNumber++)
+        for (PlayerNumber playerNumber = 0; playerNumber < playerNmb_; playerNumber++)
         {
             const auto playerEntity = GetEntityFromPlayerNumber(playerNumber);
             if (playerEntity == core::INVALID_ENTITY)
@@ -499,20 +517,17 @@ void ClientGameManager::FixedUpdate()
         core::LogWarning(fmt::format("Invalid Player Entity in {}:line {}", __FILE__, __LINE__));
         return;
     }
-    const auto& inputs = rollbackManager_.GetInputs(playerNumber);
-    auto playerInputPacket = std::make_unique<PlayerInputPacket>();
-    playerInputPacket->playerNumber = playerNumber;
-    playerInputPacket->currentFrame = core::ConvertToBinary(currentFrame_);
-    for (size_t i = 0; i < playerInputPacket->inputs.size(); i++)
+    PlayerInputPacket playerInputPacket;
+    playerInputPacket.playerNumber = playerNumber;
+    playerInputPacket.currentFrame = core::ConvertToBinary(currentFrame_);
+    //Only the inputs the server did not acknowledge are sent, the current one is always sent
+    const Frame unacknowledgedNmb = currentFrame_ >= inputAckFrame_ ? currentFrame_ - inputAckFrame_ + 1 : 1;
+    playerInputPacket.inputNmb = static_cast<std::uint8_t>(std::min<std::size_t>(MAX_INPUT_NMB, unacknowledgedNmb));
+    for (size_t i = 0; i < playerInputPacket.inputNmb; i++)
     {
-        if (i > currentFrame_)
-        {
-            break;
-        }
-
-        playerInputPacket->inputs[i] = inputs[i];
+        playerInputPacket.inputs[i] = rollbackManager_.GetInputAtFrame(playerNumber, currentFrame_ - static_cast<Frame>(i));
     }
-    packetSenderInterface_.SendUnreliablePacket(std::move(playerInputPacket));
+    packetSenderInterface_.SendUnreliablePacket(playerInputPacket);
 
     currentFrame_++;
     rollbackManager_.StartNewFrame(currentFrame_);
@@ -546,15 +561,14 @@ void ClientGameManager::DrawImGui()
     ImGui::Checkbox("Draw Physics", &drawPhysics_);
 }
 
-void ClientGameManager::ConfirmValidateFrame(Frame newValidateFrame,
-    const std::array<PhysicsState, MAX_PLAYER_NMB>& physicsStates)
+void ClientGameManager::ConfirmValidateFrame(Frame newValidateFrame, const PhysicsState physicsState)
 {
     if (newValidateFrame < rollbackManager_.GetLastValidateFrame())
     {
         core::LogWarning(fmt::format("New validate frame is too old"));
         return;
     }
-    for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB; playerNumber++)
+    for (PlayerNumber playerNumber = 0; playerNumber < playerNmb_; playerNumber++)
     {
         if (rollbackManager_.GetLastReceivedFrame(playerNumber) < newValidateFrame)
         {
@@ -569,7 +583,13 @@ void ClientGameManager::ConfirmValidateFrame(Frame newValidateFrame,
             return;
         }
     }
-    rollbackManager_.ConfirmFrame(newValidateFrame, physicsStates);
+    rollbackManager_.ConfirmFrame(newValidateFrame, physicsState);
+}
+
+void ClientGameManager::AcknowledgeInputs(Frame inputAckFrame)
+{
+    //Validate packets are unreliable and may arrive out of order
+    inputAckFrame_ = std::max(inputAckFrame_, inputAckFrame);
 }
 
 void ClientGameManager::WinGame(PlayerNumber winner)
@@ -579,11 +599,21 @@ void ClientGameManager::WinGame(PlayerNumber winner)
 
     GameManager::WinGame(winner);
 
-    const PlayerNumber loser = (winner + 1) % 2;
-    const auto& loserBody = rollbackManager_.GetCurrentPhysicsManager().GetBody(GetEntityFromPlayerNumber(loser));
-    const auto& winnerBody = rollbackManager_.GetCurrentPhysicsManager().GetBody(GetEntityFromPlayerNumber(winner));
-    SpawnEffect(EffectType::SKULL, loserBody.position, END_EFFECTS_LIFETIME);
-    SpawnEffect(EffectType::TROPHY, winnerBody.position, END_EFFECTS_LIFETIME);
+    const auto& physicsManager = rollbackManager_.GetCurrentPhysicsManager();
+    for (PlayerNumber loser = 0; loser < playerNmb_; loser++)
+    {
+        const auto loserEntity = GetEntityFromPlayerNumber(loser);
+        if (loser == winner || loserEntity == core::INVALID_ENTITY)
+        {
+            continue;
+        }
+        SpawnEffect(EffectType::SKULL, ToVec2f(physicsManager.GetBody(loserEntity).position), END_EFFECTS_LIFETIME);
+    }
+    if (winner < playerNmb_)
+    {
+        const auto& winnerBody = physicsManager.GetBody(GetEntityFromPlayerNumber(winner));
+        SpawnEffect(EffectType::TROPHY, ToVec2f(winnerBody.position), END_EFFECTS_LIFETIME);
+    }
     core::LogDebug("Winner declared on client");
 
     if (winner == GetPlayerNumber())
@@ -609,7 +639,7 @@ void ClientGameManager::UpdateCameraView()
     cameraView_ = originalView_;
     const sf::Vector2f extends{ cameraView_.getSize() / 2.0f / core::pixelPerMeter };
     float currentZoom = 1.0f;
-    for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB; playerNumber++)
+    for (PlayerNumber playerNumber = 0; playerNumber < playerNmb_; playerNumber++)
     {
         const auto playerEntity = GetEntityFromPlayerNumber(playerNumber);
         if (playerEntity == core::INVALID_ENTITY)
@@ -640,4 +670,5 @@ void ClientGameManager::UpdateCameraView()
     }
     cameraView_.zoom(currentZoom);
 }
+#endif
 }
@@ -13,7 +13,7 @@ game::GloveManager::GloveManager(core::EntityManager& entityManager, PhysicsMana
 void game::GloveManager::FixedUpdate(const sf::Time dt)
 {
 	// Loop over each player
-	for (uint8_t playerNum = 0; playerNum < MAX_PLAYER_NMB; playerNum++)
+	for (PlayerNumber playerNum = 0; playerNum < gameManager_.GetPlayerNmb(); playerNum++)
 	{
 		const core::Entity playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNum);
 		Body playerBody = physicsManager_.GetBody(playerEntity);
@@ -24,9 +24,9 @@ void game::GloveManager::FixedUpdate(const sf::Time dt)
 			Glove glove = GetComponent(gloveEntity);
 			Body gloveBody = physicsManager_.GetBody(gloveEntity);
 
-			core::Vec2f relativeUp = core::Vec2f::up().Rotate(-playerBody.rotation);
+			Vec2 relativeUp = Vec2::up().Rotate(-playerBody.rotation);
 			// Get the absolute point where the glove should try to be
-			const core::Vec2f goalPos = playerBody.position + (relativeUp * GLOVE_IDEAL_DIST).Rotate(GLOVE_IDEAL_ANGLE * glove.sign);
+			const Vec2 goalPos = playerBody.position + (relativeUp * GLOVE_IDEAL_DIST).Rotate(ToAngle(GLOVE_IDEAL_ANGLE) * glove.sign);
 
 			if (glove.punchingTime >= 0.0f)
 			{
@@ -45,7 +45,7 @@ void game::GloveManager::FixedUpdate(const sf::Time dt)
 					{
 						float ratio = std::clamp((GLOVE_RECOVERY_TIME - glove.recoveryTime) / GLOVE_RECOVERY_TIME,
 							0.0f, 1.0f);
-						gloveBody.position = core::Vec2f::Lerp(glove.returningFromPos, goalPos, ratio);
+						gloveBody.position = Vec2::Lerp(glove.returningFromPos, goalPos, ratio);
 					}
 					else
 					{
@@ -76,10 +76,10 @@ void game::GloveManager::FixedUpdate(const sf::Time dt)
 			else
 				// Apply constraints
 			{
-				core::Vec2f toGlove = gloveBody.position - playerBody.position;
+				Vec2 toGlove = gloveBody.position - playerBody.position;
 
 				// Project the glove against the ring formed by the min and max circles
-				if (const float toGloveLength = toGlove.GetMagnitude(); toGloveLength > GLOVE_MAX_DIST)
+				if (const Scalar toGloveLength = toGlove.GetMagnitude(); toGloveLength > GLOVE_MAX_DIST)
 				{
 					gloveBody.position = playerBody.position + toGlove.GetNormalized() * GLOVE_MAX_DIST;
 					toGlove = gloveBody.position - playerBody.position;
@@ -92,20 +92,19 @@ void game::GloveManager::FixedUpdate(const sf::Time dt)
 
 				// Force the glove to be in a certain sector of the bounding ring
 
-				core::Degree angleWithUp = core::GetPosAngle(core::Atan2(toGlove.y, toGlove.x)
-					- core::Atan2(relativeUp.y, relativeUp.x));
+				const Angle angleWithUp = GetPosAngleBetween(relativeUp, toGlove);
 
 				// Set the correct bounds for the glove
-				const core::Degree bound1 = core::GetPosAngle(glove.sign >= 1.0f ? GLOVE_ANGLE_1 : GLOVE_ANGLE_2 * glove.sign);
-				const core::Degree bound2 = core::GetPosAngle(glove.sign >= 1.0f ? GLOVE_ANGLE_2 : GLOVE_ANGLE_1 * glove.sign);
+				const Angle bound1 = core::GetPosAngle(glove.sign >= 1.0f ? ToAngle(GLOVE_ANGLE_1) : ToAngle(GLOVE_ANGLE_2) * glove.sign);
+				const Angle bound2 = core::GetPosAngle(glove.sign >= 1.0f ? ToAngle(GLOVE_ANGLE_2) : ToAngle(GLOVE_ANGLE_1) * glove.sign);
 
 				// Check if outstide sector
-				if (core::GetPosAngle(bound2 - bound1).value()
-					< core::GetPosAngle(angleWithUp - bound1).value())
+				if (GetDegrees(core::GetPosAngle(bound2 - bound1))
+					< GetDegrees(core::GetPosAngle(angleWithUp - bound1)))
 				{
 					// Find which bound is the closest
-					float dist1 = core::GetPosAngle(angleWithUp - bound1).value();
-					float dist2 = core::GetPosAngle(angleWithUp - bound2).value();
+					Scalar dist1 = GetDegrees(core::GetPosAngle(angleWithUp - bound1));
+					Scalar dist2 = GetDegrees(core::GetPosAngle(angleWithUp - bound2));
 					float constexpr halfCircle = 180.0f;
 					if (dist1 > halfCircle)
 					{
@@ -153,7 +152,7 @@ void game::GloveManager::StartReturn(const core::Entity gloveEntity)
 	physicsManager_.SetCol(gloveEntity, col);
 
 	Body body = physicsManager_.GetBody(gloveEntity);
-	body.velocity = core::Vec2f::zero();
+	body.velocity = Vec2::zero();
 	physicsManager_.SetBody(gloveEntity, body);
 
 	glove.returningFromPos = body.position;
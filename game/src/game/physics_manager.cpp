@@ -1,6 +1,14 @@
 #include "game/physics_manager.h"
 
+#ifndef GAME_HEADLESS
 #include <SFML/Graphics/CircleShape.hpp>
+#endif
+
+#include "engine/view.h"
+#include "maths/collision.h"
+
+#include <algorithm>
+#include <cmath>
 
 #ifdef TRACY_ENABLE
 #include <Tracy.hpp>
@@ -15,18 +23,19 @@ PhysicsManager::PhysicsManager(core::EntityManager& entityManager) :
 
 }
 
-bool radiiIntersect(const core::Vec2f pos1, const float r1, const core::Vec2f pos2, const float r2)
+bool radiiIntersect(const Vec2 pos1, const Scalar r1, const Vec2 pos2, const Scalar r2)
 {
-    return (pos1 - pos2).GetMagnitude() <= (r1 + r2);
+    const Scalar radii = r1 + r2;
+    return (pos1 - pos2).GetSqrMagnitude() <= radii * radii;
 }
 
-void SolveOverlap(Body& rb1, Body& rb2, const float radii)
+void SolveOverlap(Body& rb1, Body& rb2, const Scalar radii)
 {
     //Find proportions of displacement according to masses, the less mass they have, the more they move
-    const float m1 = rb1.mass;
-    const float m2 = rb2.mass;
-    float prop1 = m2 / (m1 + m2);
-    float prop2 = m1 / (m1 + m2);
+    const Scalar m1 = rb1.mass;
+    const Scalar m2 = rb2.mass;
+    Scalar prop1 = m2 / (m1 + m2);
+    Scalar prop2 = m1 / (m1 + m2);
 
     if (rb1.bodyType == BodyType::STATIC)
     {
@@ -47,10 +56,10 @@ void SolveOverlap(Body& rb1, Body& rb2, const float radii)
         prop1 = 1.0f;
     }
 
-    static constexpr float epsilon = 0.01f;
+    static constexpr Scalar epsilon = 0.01f;
 
     //Move shapes out of each other with minimum translation vector
-    const core::Vec2f mtv = (rb1.position - rb2.position).GetNormalized() *
+    const Vec2 mtv = (rb1.position - rb2.position).GetNormalized() *
         (radii - (rb1.position - rb2.position).GetMagnitude() + epsilon);
     rb1.position = rb1.position + mtv * prop1;
     rb2.position = rb2.position - mtv * prop2;
@@ -63,16 +72,16 @@ void SolveVelocities(Body& rb1, Body& rb2)
         return;
 
     // Calculate normal
-    const core::Vec2f normal = (rb1.position - rb2.position).GetNormalized();
+    const Vec2 normal = (rb1.position - rb2.position).GetNormalized();
 
     if (rb1.bodyType == BodyType::STATIC || rb2.bodyType == BodyType::STATIC)
     {
         Body& nonStatic = !(rb1.bodyType == BodyType::STATIC) ? rb1 : rb2;
 
-        const core::Vec2f v = nonStatic.velocity;
-        const core::Vec2f n = normal * -1.0;
-        core::Vec2f v1;
-        const float k = 2.0f * core::Vec2f::Dot(v, n);
+        const Vec2 v = nonStatic.velocity;
+        const Vec2 n = normal * -1.0f;
+        Vec2 v1;
+        const Scalar k = 2.0f * Vec2::Dot(v, n);
         v1.x = v.x - k * n.x;
         v1.y = v.y - k * n.y;
 
@@ -80,29 +89,19 @@ void SolveVelocities(Body& rb1, Body& rb2)
         return;
     }
 
-    const float v1 = rb1.velocity.GetMagnitude();
-	const float v2 = rb2.velocity.GetMagnitude();
-
-    const float m1 = rb1.mass;
-    const float m2 = rb2.mass;
-
-    const float theta1 = std::atan2f(rb1.velocity.y, rb1.velocity.x);
-    const float theta2 = std::atan2f(rb2.velocity.y, rb2.velocity.x);
-
-    const float phi = std::atan2f(normal.y, normal.x);
-
-    const float v1fx = ((v1 * std::cos(theta1 - phi) * (m1 - m2) + 2 * m2 * v2 * std::cos(theta2 - phi)) / (m1 + m2))
-        * std::cos(phi) + v1 * std::sin(theta1 - phi) * std::cos(phi + core::PI / 2);
-    const float v1fy = ((v1 * std::cos(theta1 - phi) * (m1 - m2) + 2 * m2 * v2 * std::cos(theta2 - phi)) / (m1 + m2))
-        * std::sin(phi) + v1 * std::sin(theta1 - phi) * std::sin(phi + core::PI / 2);
-
-    const float v2fx = ((v2 * std::cos(theta2 - phi) * (m2 - m1) + 2 * m1 * v1 * std::cos(theta1 - phi)) / (m2 + m1))
-        * std::cos(phi) + v2 * std::sin(theta2 - phi) * std::cos(phi + core::PI / 2);
-    const float v2fy = ((v2 * std::cos(theta2 - phi) * (m2 - m1) + 2 * m1 * v1 * std::cos(theta1 - phi)) / (m2 + m1))
-        * std::sin(phi) + v2 * std::sin(theta2 - phi) * std::sin(phi + core::PI / 2);
+    core::SolveElasticCollision(rb1.velocity, rb1.mass, rb2.velocity, rb2.mass, normal);
+}
 
-    rb1.velocity = { v1fx, v1fy };
-    rb2.velocity = { v2fx, v2fy };
+void BodyManager::ApplyVelocities(const sf::Time dt)
+{
+    for (std::size_t i = 0; i < packed_.entities.size(); i++)
+    {
+        if (!entityManager_.HasComponent(packed_.entities[i], static_cast<core::EntityMask>(core::ComponentType::BODY2D)))
+            continue;
+        auto& body = packed_.components[i];
+        body.position += body.velocity * dt.asSeconds();
+        body.rotation += body.angularVelocity * dt.asSeconds();
+    }
 }
 
 void PhysicsManager::FixedUpdate(const sf::Time dt)
@@ -111,59 +110,72 @@ void PhysicsManager::FixedUpdate(const sf::Time dt)
     ZoneScoped;
 #endif
     // Apply velocities
-    for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
-    {
-        if (!entityManager_.HasComponent(entity, static_cast<core::EntityMask>(core::ComponentType::BODY2D)))
-            continue;
-        auto body = bodyManager_.GetComponent(entity);
-        body.position += body.velocity * dt.asSeconds();
-        body.rotation += body.angularVelocity * dt.asSeconds();
-        bodyManager_.SetComponent(entity, body);
-    }
+    bodyManager_.ApplyVelocities(dt);
     // Check collisions
-    for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+    BuildCollisionPairs();
+    std::size_t pairIndex = 0;
+    while (pairIndex < broadPhase_.GetPairs().size())
     {
-        if (!entityManager_.HasComponent(entity,
-            static_cast<core::EntityMask>(core::ComponentType::BODY2D) |
-            static_cast<core::EntityMask>(core::ComponentType::CIRCLE_COLLIDER2D)) ||
-            entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
-            continue;
-
-        for (core::Entity otherEntity = entity + 1; otherEntity < entityManager_.GetEntitiesSize(); otherEntity++)
-        {
-            if (!entityManager_.HasComponent(otherEntity,
-                static_cast<core::EntityMask>(core::ComponentType::BODY2D) | static_cast<core::EntityMask>(core::ComponentType::CIRCLE_COLLIDER2D)) ||
-                entityManager_.HasComponent(otherEntity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
-            {
-                continue;
-            }
+        const auto [entity, otherEntity] = broadPhase_.GetPairs()[pairIndex];
+        pairIndex++;
+        Body& rb1 = bodyManager_.GetComponent(entity);
+        const Circle& col1 = colManager_.GetComponent(entity);
 
-            Body& rb1 = bodyManager_.GetComponent(entity);
-            const Circle& col1 = colManager_.GetComponent(entity);
+        Body& rb2 = bodyManager_.GetComponent(otherEntity);
+        const Circle& col2 = colManager_.GetComponent(otherEntity);
 
-        	Body& rb2 = bodyManager_.GetComponent(otherEntity);
-            const Circle& col2 = colManager_.GetComponent(otherEntity);
+        if (!col1.enabled || !col2.enabled)
+        {
+            continue;
+        }
 
-            if (!col1.enabled || !col2.enabled)
+        if (radiiIntersect(rb1.position, col1.radius, rb2.position, col2.radius))
+        {
+            if (col1.isTrigger || col2.isTrigger)
             {
-	            continue;
+                onTriggerAction_.Execute(entity, otherEntity);
             }
-
-            if (radiiIntersect(rb1.position, col1.radius, rb2.position, col2.radius))
+            else
             {
-                if (col1.isTrigger || col2.isTrigger)
+                SolveVelocities(rb1, rb2);
+                SolveOverlap(rb1, rb2, col1.radius + col2.radius);
+                //Like the all-pairs loop, the next pairs see the pushed bodies, so their pairs are built again when they moved too far.
+                //The margin doubles each time, a crowd of overlaps only needs a few builds before the grid is a single cell.
+                if (IsPushedOutOfBroadPhase(entity) || IsPushedOutOfBroadPhase(otherEntity))
                 {
-					onTriggerAction_.Execute(entity, otherEntity);
-                }
-                else
-                {
-                    SolveVelocities(rb1, rb2);
-                    SolveOverlap(rb1, rb2, col1.radius + col2.radius);
+                    BuildCollisionPairs(2.0f * broadPhase_.GetMargin());
+                    const auto& pairs = broadPhase_.GetPairs();
+                    pairIndex = static_cast<std::size_t>(std::upper_bound(pairs.begin(), pairs.end(),
+                        std::make_pair(entity, otherEntity)) - pairs.begin());
                 }
             }
         }
     }
 }
+
+void PhysicsManager::BuildCollisionPairs(float minMargin)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    broadPhase_.Clear();
+    broadPhasePositions_.resize(entityManager_.GetEntitiesSize());
+    for (const auto& [entity, body, col] : core::View(entityManager_, bodyManager_, colManager_)
+        .Exclude(static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+    {
+        const auto position = ToVec2f(body.position);
+        broadPhase_.AddCollider(entity, position, ToFloat(col.radius));
+        broadPhasePositions_[entity] = position;
+    }
+    broadPhase_.BuildPairs(minMargin);
+}
+
+bool PhysicsManager::IsPushedOutOfBroadPhase(core::Entity entity) const
+{
+    const float maxPush = broadPhase_.GetMargin() / 2.0f;
+    return (ToVec2f(bodyManager_.GetComponent(entity).position) - broadPhasePositions_[entity]).GetSqrMagnitude() >
+        maxPush * maxPush;
+}
      
 void PhysicsManager::SetBody(const core::Entity entity, const Body& body)
 {
@@ -203,26 +215,28 @@ void PhysicsManager::RegisterTriggerListener(OnTriggerInterface& onTriggerInterf
 
 void PhysicsManager::CopyAllComponents(const PhysicsManager& physicsManager)
 {
-    bodyManager_.CopyAllComponents(physicsManager.bodyManager_.GetAllComponents());
-    colManager_.CopyAllComponents(physicsManager.colManager_.GetAllComponents());
+    bodyManager_.CopyAllComponents(physicsManager.bodyManager_.GetPackedComponents());
+    colManager_.CopyAllComponents(physicsManager.colManager_.GetPackedComponents());
+}
+
+void PhysicsManager::CopyAllComponents(const core::PackedComponents<Body>& bodies, const core::PackedComponents<Circle>& cols)
+{
+    bodyManager_.CopyAllComponents(bodies);
+    colManager_.CopyAllComponents(cols);
 }
 
+#ifndef GAME_HEADLESS
 void PhysicsManager::Draw(sf::RenderTarget& renderTarget)
 {
-    for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+    for (const auto& [entity, body, col] : core::View(entityManager_, bodyManager_, colManager_)
+        .Exclude(static_cast<core::EntityMask>(ComponentType::DESTROYED)))
     {
-        if (!entityManager_.HasComponent(entity,
-            static_cast<core::EntityMask>(core::ComponentType::BODY2D) |
-            static_cast<core::EntityMask>(core::ComponentType::CIRCLE_COLLIDER2D)) ||
-            entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
-            continue;
-        const auto& [radius, isTrigger, enabled] = colManager_.GetComponent(entity);
-        const auto& body = bodyManager_.GetComponent(entity);
+        const float radius = ToFloat(col.radius);
         sf::CircleShape circleShape;
         circleShape.setFillColor(core::Color::transparent());
         circleShape.setOutlineColor(core::Color::green());
         circleShape.setOutlineThickness(2.0f);
-        const auto position = body.position;
+        const auto position = ToVec2f(body.position);
         circleShape.setOrigin({ radius * core::pixelPerMeter, radius * core::pixelPerMeter });
         circleShape.setPosition(
             position.x * core::pixelPerMeter + center_.x,
@@ -231,4 +245,5 @@ void PhysicsManager::Draw(sf::RenderTarget& renderTarget)
         renderTarget.draw(circleShape);
     }
 }
+#endif
 }
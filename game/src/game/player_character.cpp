@@ -20,7 +20,7 @@ void PlayerCharacterManager::FixedUpdate(const sf::Time dt)
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB; playerNumber++)
+    for (PlayerNumber playerNumber = 0; playerNumber < gameManager_.GetPlayerNmb(); playerNumber++)
     {
         const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
         if (!entityManager_.HasComponent(playerEntity,
@@ -37,10 +37,10 @@ void PlayerCharacterManager::FixedUpdate(const sf::Time dt)
         const std::array punch = { static_cast<bool>(input & PlayerInputEnum::PlayerInput::PUNCH),
             static_cast<bool>(input & PlayerInputEnum::PlayerInput::PUNCH2) };
 
-        const auto rotation = ((left ? -1.0f : 0.0f) + (right ? 1.0f : 0.0f)) * PLAYER_ROTATIONAL_SPEED * dt.asSeconds();
+        const Angle rotation = ToAngle(PLAYER_ROTATIONAL_SPEED) * ((left ? -1.0f : 0.0f) + (right ? 1.0f : 0.0f)) * dt.asSeconds();
         playerBody.rotation += rotation;
 
-        const auto dir = core::Vec2f::up().Rotate(-playerBody.rotation);
+        const auto dir = Vec2::up().Rotate(-playerBody.rotation);
 
         const auto speed = ((down ? -1.0f : 0.0f) + (up ? 1.0f : 0.0f)) * dir * PLAYER_SPEED;
 
@@ -49,7 +49,7 @@ void PlayerCharacterManager::FixedUpdate(const sf::Time dt)
         {
             playerBody.velocity += speed * dt.asSeconds();
 
-            if (playerBody.velocity != core::Vec2f::zero())
+            if (playerBody.velocity != Vec2::zero())
             {
                 if (playerBody.velocity.GetMagnitude() > PLAYER_MAX_SPEED)
                 {
@@ -0,0 +1,213 @@
+#include "game/replay.h"
+#include "game/game_manager.h"
+#include "utils/conversion.h"
+#include "utils/log.h"
+
+#include <fmt/format.h>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+namespace
+{
+constexpr PlayerInput REPLAY_INPUT_MASK = (1u << REPLAY_INPUT_BIT_NMB) - 1u;
+static_assert(PlayerInputEnum::PUNCH2 <= REPLAY_INPUT_MASK, "The replay inputs need a bit for each PlayerInputEnum flag");
+
+template<typename T>
+void WriteValue(std::ofstream& file, T value)
+{
+    const auto data = core::ConvertToBinary(value);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+template<typename T>
+bool ReadValue(std::ifstream& file, T& value)
+{
+    std::array<std::uint8_t, sizeof(T)> data{};
+    if (!file.read(reinterpret_cast<char*>(data.data()), data.size()))
+    {
+        return false;
+    }
+    value = core::ConvertFromBinary<T>(data);
+    return true;
+}
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    Close();
+}
+
+bool ReplayWriter::Open(std::string_view path, const GameManager& gameManager)
+{
+    file_.open(std::string(path), std::ios::binary | std::ios::trunc);
+    if (!file_)
+    {
+        core::LogWarning(fmt::format("[Replay] Could not create replay file: {}", path));
+        return false;
+    }
+    playerNmb_ = gameManager.GetPlayerNmb();
+    lastWrittenFrame_ = gameManager.GetLastValidateFrame();
+    chunkFirstFrame_ = lastWrittenFrame_ + 1;
+    chunkInputs_.clear();
+
+    file_.write(REPLAY_MAGIC.data(), REPLAY_MAGIC.size());
+    WriteValue(file_, REPLAY_VERSION);
+    WriteValue(file_, static_cast<std::uint8_t>(playerNmb_));
+    const auto& transformManager = gameManager.GetTransformManager();
+    for (PlayerNumber playerNumber = 0; playerNumber < playerNmb_; playerNumber++)
+    {
+        const auto entity = gameManager.GetEntityFromPlayerNumber(playerNumber);
+        const auto position = transformManager.GetPosition(entity);
+        WriteValue(file_, position.x);
+        WriteValue(file_, position.y);
+        WriteValue(file_, transformManager.GetRotation(entity).value());
+    }
+    core::LogDebug(fmt::format("[Replay] Recording {} players in: {}", playerNmb_, path));
+    return true;
+}
+
+void ReplayWriter::WriteValidatedFrames(const GameManager& gameManager)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (!IsOpen())
+    {
+        return;
+    }
+    const auto& rollbackManager = gameManager.GetRollbackManager();
+    const auto validateFrame = rollbackManager.GetLastValidateFrame();
+    for (Frame frame = lastWrittenFrame_ + 1; frame <= validateFrame; frame++)
+    {
+        for (PlayerNumber playerNumber = 0; playerNumber < playerNmb_; playerNumber++)
+        {
+            chunkInputs_.push_back(rollbackManager.GetInputAtFrame(playerNumber, frame));
+        }
+    }
+    lastWrittenFrame_ = std::max(lastWrittenFrame_, validateFrame);
+    chunkPhysicsState_ = rollbackManager.GetValidatePhysicsState();
+    if (lastWrittenFrame_ + 1 - chunkFirstFrame_ >= REPLAY_CHUNK_FRAME_NMB)
+    {
+        WriteChunk();
+    }
+}
+
+void ReplayWriter::Close()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+    WriteChunk();
+    file_.close();
+}
+
+void ReplayWriter::WriteChunk()
+{
+    const auto frameNmb = lastWrittenFrame_ + 1 - chunkFirstFrame_;
+    if (frameNmb == 0)
+    {
+        return;
+    }
+    //The inputs are packed one after the other from the lowest bit of each byte
+    packedInputs_.assign((chunkInputs_.size() * REPLAY_INPUT_BIT_NMB + 7) / 8, 0);
+    std::size_t bitIndex = 0;
+    for (const auto input : chunkInputs_)
+    {
+        const unsigned value = input & REPLAY_INPUT_MASK;
+        const auto byteIndex = bitIndex / 8;
+        const auto bitOffset = bitIndex % 8;
+        packedInputs_[byteIndex] |= static_cast<std::uint8_t>(value << bitOffset);
+        if (bitOffset + REPLAY_INPUT_BIT_NMB > 8)
+        {
+            packedInputs_[byteIndex + 1] |= static_cast<std::uint8_t>(value >> (8 - bitOffset));
+        }
+        bitIndex += REPLAY_INPUT_BIT_NMB;
+    }
+    WriteValue(file_, static_cast<std::uint16_t>(frameNmb));
+    WriteValue(file_, chunkPhysicsState_);
+    file_.write(reinterpret_cast<const char*>(packedInputs_.data()), static_cast<std::streamsize>(packedInputs_.size()));
+    if (!file_)
+    {
+        core::LogWarning("[Replay] Could not write in the replay file, the recording stops");
+        file_.close();
+    }
+    chunkFirstFrame_ = lastWrittenFrame_ + 1;
+    chunkInputs_.clear();
+}
+
+bool ReplayReader::Open(std::string_view path)
+{
+    file_.open(std::string(path), std::ios::binary);
+    if (!file_)
+    {
+        core::LogWarning(fmt::format("[Replay] Could not open replay file: {}", path));
+        return false;
+    }
+    std::array<char, REPLAY_MAGIC.size()> magic{};
+    std::uint8_t version = 0;
+    std::uint8_t playerNmb = 0;
+    if (!file_.read(magic.data(), magic.size()) || magic != REPLAY_MAGIC ||
+        !ReadValue(file_, version) || version != REPLAY_VERSION ||
+        !ReadValue(file_, playerNmb) || playerNmb == 0 || playerNmb > MAX_PLAYER_NMB)
+    {
+        core::LogWarning(fmt::format("[Replay] {} is not a replay file of version {}", path, REPLAY_VERSION));
+        return false;
+    }
+    playerNmb_ = playerNmb;
+    for (PlayerNumber playerNumber = 0; playerNumber < playerNmb_; playerNumber++)
+    {
+        auto& spawn = spawns_[playerNumber];
+        float rotation = 0.0f;
+        if (!ReadValue(file_, spawn.position.x) || !ReadValue(file_, spawn.position.y) || !ReadValue(file_, rotation))
+        {
+            core::LogWarning(fmt::format("[Replay] {} is truncated", path));
+            return false;
+        }
+        spawn.rotation = core::Degree(rotation);
+    }
+    nextFrame_ = 1;
+    return true;
+}
+
+bool ReplayReader::ReadChunk(ReplayChunk& chunk)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    std::uint16_t frameNmb = 0;
+    if (!ReadValue(file_, frameNmb) || frameNmb == 0 || !ReadValue(file_, chunk.physicsState))
+    {
+        return false;
+    }
+    const std::size_t inputNmb = static_cast<std::size_t>(frameNmb) * playerNmb_;
+    packedInputs_.resize((inputNmb * REPLAY_INPUT_BIT_NMB + 7) / 8);
+    if (!file_.read(reinterpret_cast<char*>(packedInputs_.data()), static_cast<std::streamsize>(packedInputs_.size())))
+    {
+        core::LogWarning("[Replay] The last chunk of the replay is truncated");
+        return false;
+    }
+    chunk.inputs.resize(inputNmb);
+    std::size_t bitIndex = 0;
+    for (auto& input : chunk.inputs)
+    {
+        const auto byteIndex = bitIndex / 8;
+        const auto bitOffset = bitIndex % 8;
+        unsigned value = packedInputs_[byteIndex] >> bitOffset;
+        if (bitOffset + REPLAY_INPUT_BIT_NMB > 8)
+        {
+            value |= static_cast<unsigned>(packedInputs_[byteIndex + 1]) << (8 - bitOffset);
+        }
+        input = static_cast<PlayerInput>(value & REPLAY_INPUT_MASK);
+        bitIndex += REPLAY_INPUT_BIT_NMB;
+    }
+    chunk.firstFrame = nextFrame_;
+    chunk.lastFrame = nextFrame_ + frameNmb - 1;
+    nextFrame_ = chunk.lastFrame + 1;
+    return true;
+}
+}
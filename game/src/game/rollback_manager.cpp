@@ -1,6 +1,7 @@
 #include <game/rollback_manager.h>
 #include <game/game_manager.h>
 #include "utils/assert.h"
+#include "utils/hash.h"
 #include <utils/log.h>
 #include <fmt/format.h>
 
@@ -11,20 +12,83 @@
 namespace game
 {
 
+PlayerInputBuffer::PlayerInputBuffer()
+{
+	//The input of the first frame is known to be empty
+	confirmed_.set(0);
+}
+
+PlayerInput PlayerInputBuffer::GetInput(Frame frame) const
+{
+	//The frames after the last received one repeat the last received input
+	const auto storedFrame = std::min(frame, lastReceivedFrame_);
+	gpr_assert(lastReceivedFrame_ - storedFrame < WINDOW_BUFFER_SIZE,
+		"Trying to get input too far in the past");
+	return inputs_[storedFrame % WINDOW_BUFFER_SIZE];
+}
+
+bool PlayerInputBuffer::IsConfirmed(Frame frame) const
+{
+	if (frame > lastReceivedFrame_ || lastReceivedFrame_ - frame >= WINDOW_BUFFER_SIZE)
+	{
+		return false;
+	}
+	return confirmed_[frame % WINDOW_BUFFER_SIZE];
+}
+
+Frame PlayerInputBuffer::SetInput(Frame frame, PlayerInput input)
+{
+	if (frame <= lastReceivedFrame_)
+	{
+		if (lastReceivedFrame_ - frame >= WINDOW_BUFFER_SIZE)
+		{
+			return INVALID_FRAME;
+		}
+		const auto index = frame % WINDOW_BUFFER_SIZE;
+		confirmed_.set(index);
+		AdvanceFirstMissingFrame();
+		if (inputs_[index] == input)
+		{
+			return INVALID_FRAME;
+		}
+		inputs_[index] = input;
+		return frame;
+	}
+	//The skipped frames keep the input they were predicted with until they are received
+	const PlayerInput predictedInput = inputs_[lastReceivedFrame_ % WINDOW_BUFFER_SIZE];
+	const Frame windowStart = frame >= WINDOW_BUFFER_SIZE ? frame - WINDOW_BUFFER_SIZE + 1 : 0;
+	for (Frame predictedFrame = std::max(lastReceivedFrame_ + 1, windowStart); predictedFrame < frame; predictedFrame++)
+	{
+		inputs_[predictedFrame % WINDOW_BUFFER_SIZE] = predictedInput;
+		confirmed_.reset(predictedFrame % WINDOW_BUFFER_SIZE);
+	}
+	inputs_[frame % WINDOW_BUFFER_SIZE] = input;
+	confirmed_.set(frame % WINDOW_BUFFER_SIZE);
+	lastReceivedFrame_ = frame;
+	AdvanceFirstMissingFrame();
+	return input != predictedInput ? frame : INVALID_FRAME;
+}
+
+void PlayerInputBuffer::AdvanceFirstMissingFrame()
+{
+	if (lastReceivedFrame_ >= WINDOW_BUFFER_SIZE)
+	{
+		firstMissingFrame_ = std::max(firstMissingFrame_, lastReceivedFrame_ - static_cast<Frame>(WINDOW_BUFFER_SIZE) + 1);
+	}
+	while (firstMissingFrame_ <= lastReceivedFrame_ && confirmed_[firstMissingFrame_ % WINDOW_BUFFER_SIZE])
+	{
+		firstMissingFrame_++;
+	}
+}
+
 RollbackManager::RollbackManager(GameManager& gameManager, core::EntityManager& entityManager) :
 	gameManager_(gameManager), entityManager_(entityManager),
 	currentTransformManager_(entityManager),
 	currentPhysicsManager_(entityManager),
-	currentPlayerManager_(entityManager, currentPhysicsManager_, gameManager_, currentGloveManager_), currentGloveManager_(entityManager, currentPhysicsManager_, gameManager),
-	lastValidatedPhysicsManager_(entityManager),
-	lastValidatedPlayerManager_(entityManager, lastValidatedPhysicsManager_, gameManager_, lastValidatedGloveManager_),
-	lastValidatedGloveManager_(entityManager, lastValidatedPhysicsManager_, gameManager)
+	currentPlayerManager_(entityManager, currentPhysicsManager_, gameManager_, currentGloveManager_), currentGloveManager_(entityManager, currentPhysicsManager_, gameManager)
 {
-	for (auto& input : inputs_)
-	{
-		std::fill(input.begin(), input.end(), '\0');
-	}
 	currentPhysicsManager_.RegisterTriggerListener(*this);
+	SaveSnapshot(lastValidatedFrame_);
 }
 
 void RollbackManager::SimulateToCurrentFrame()
@@ -32,19 +96,33 @@ void RollbackManager::SimulateToCurrentFrame()
 #ifdef TRACY_ENABLE
 	ZoneScoped;
 #endif
+	const auto simulateStart = std::chrono::steady_clock::now();
 	reSimulating_ = true;
 
 	const auto currentFrame = gameManager_.GetCurrentFrame();
 	const auto lastValidateFrame = gameManager_.GetLastValidateFrame();
-	//Destroying all created Entities after the last validated frame
-	for (const auto& createdEntity : createdEntities_)
+	gpr_assert(currentFrame - lastValidateFrame < WINDOW_BUFFER_SIZE,
+		"The validated snapshot would be overwritten by the predicted frames");
+	//We only go back to the frame before the first input that changed, or advance from the last simulated frame
+	Frame restoreFrame = std::min(lastSimulatedFrame_, currentFrame);
+	if (firstMispredictedFrame_ <= restoreFrame)
 	{
-		if (createdEntity.createdFrame > lastValidateFrame)
-		{
-			entityManager_.DestroyEntity(createdEntity.entity);
-		}
+		restoreFrame = firstMispredictedFrame_ > 0 ? firstMispredictedFrame_ - 1 : 0;
 	}
-	createdEntities_.clear();
+	restoreFrame = std::max(restoreFrame, lastValidateFrame);
+	//Destroying all created Entities after the restored frame
+	std::erase_if(createdEntities_, [this, restoreFrame](const CreatedEntity& createdEntity)
+		{
+			if (createdEntity.createdFrame > restoreFrame)
+			{
+				if (entityManager_.IsEntityValid(createdEntity.entity, createdEntity.generation))
+				{
+					entityManager_.DestroyEntity(createdEntity.entity);
+				}
+				return true;
+			}
+			return false;
+		});
 	//Remove DESTROY flags
 	for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
 	{
@@ -54,33 +132,23 @@ void RollbackManager::SimulateToCurrentFrame()
 		}
 	}
 
-	//Revert the current game state to the last validated game state
-	currentPhysicsManager_.CopyAllComponents(lastValidatedPhysicsManager_);
-	currentPlayerManager_.CopyAllComponents(lastValidatedPlayerManager_.GetAllComponents());
-	currentGloveManager_.CopyAllComponents(lastValidatedGloveManager_.GetAllComponents());
+	//Revert the current game state to the snapshot before the first mispredicted input
+	if (stateFrame_ != restoreFrame)
+	{
+		LoadSnapshot(restoreFrame);
+	}
 
-	for (Frame frame = lastValidateFrame + 1; frame <= currentFrame; frame++)
+	for (Frame frame = restoreFrame + 1; frame <= currentFrame; frame++)
 	{
-		testedFrame_ = frame;
-		//Copy player inputs to player manager
-		for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB; playerNumber++)
-		{
-			const auto playerInput = GetInputAtFrame(playerNumber, frame);
-			const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
-			if (playerEntity == core::INVALID_ENTITY)
-			{
-				core::LogWarning(fmt::format("Invalid Entity in {}:line {}", __FILE__, __LINE__));
-				continue;
-			}
-			PlayerCharacter playerCharacter = currentPlayerManager_.GetComponent(playerEntity);
-			playerCharacter.input = playerInput;
-			currentPlayerManager_.SetComponent(playerEntity, playerCharacter);
-		}
-		//Simulate one frame of the game
-		currentPlayerManager_.FixedUpdate(sf::seconds(FIXED_PERIOD));
-		currentGloveManager_.FixedUpdate(sf::seconds(FIXED_PERIOD));
-		currentPhysicsManager_.FixedUpdate(sf::seconds(FIXED_PERIOD));
+		SimulateFrame(frame);
+		SaveSnapshot(frame);
+	}
+	if (currentFrame > restoreFrame)
+	{
+		simulatedFrameNmb_ += currentFrame - restoreFrame;
 	}
+	lastSimulatedFrame_ = std::max(restoreFrame, currentFrame);
+	firstMispredictedFrame_ = INVALID_FRAME;
 	//Copy the physics states to the transforms
 	for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
 	{
@@ -89,11 +157,12 @@ void RollbackManager::SimulateToCurrentFrame()
 			static_cast<core::EntityMask>(core::ComponentType::TRANSFORM)))
 			continue;
 		const auto& body = currentPhysicsManager_.GetBody(entity);
-		currentTransformManager_.SetPosition(entity, body.position);
-		currentTransformManager_.SetRotation(entity, body.rotation);
+		currentTransformManager_.SetPosition(entity, ToVec2f(body.position));
+		currentTransformManager_.SetRotation(entity, ToDegree(body.rotation));
 	}
 
 	reSimulating_ = false;
+	lastSimulateDuration_ = std::chrono::steady_clock::now() - simulateStart;
 }
 
 void RollbackManager::SetPlayerInput(PlayerNumber playerNumber, PlayerInput playerInput, Frame inputFrame)
@@ -103,16 +172,9 @@ void RollbackManager::SetPlayerInput(PlayerNumber playerNumber, PlayerInput play
 	{
 		StartNewFrame(inputFrame);
 	}
-	inputs_[playerNumber][currentInputFrame_ - inputFrame] = playerInput;
-	if (lastReceivedFrame_[playerNumber] < inputFrame)
-	{
-		lastReceivedFrame_[playerNumber] = inputFrame;
-		//Repeat the same inputs until currentFrame
-		for (size_t i = 0; i < currentInputFrame_ - inputFrame; i++)
-		{
-			inputs_[playerNumber][i] = playerInput;
-		}
-	}
+	//Only a different input invalidates the frames simulated with the predicted one
+	const Frame changedFrame = inputs_[playerNumber].SetInput(inputFrame, playerInput);
+	firstMispredictedFrame_ = std::min(firstMispredictedFrame_, changedFrame);
 }
 
 void RollbackManager::StartNewFrame(Frame newFrame)
@@ -121,26 +183,8 @@ void RollbackManager::StartNewFrame(Frame newFrame)
 #ifdef TRACY_ENABLE
 	ZoneScoped;
 #endif
-	if (currentInputFrame_ > newFrame)
-		return;
-	const auto delta = newFrame - currentInputFrame_;
-	if (delta == 0)
-	{
-		return;
-	}
-	for (auto& inputs : inputs_)
-	{
-		for (auto i = inputs.size() - 1; i >= delta; i--)
-		{
-			inputs[i] = inputs[i - delta];
-		}
-
-		for (Frame i = 0; i < delta; i++)
-		{
-			inputs[i] = inputs[delta];
-		}
-	}
-	currentInputFrame_ = newFrame;
+	//The inputs are indexed by frame, so there is nothing to shift
+	currentInputFrame_ = std::max(currentInputFrame_, newFrame);
 }
 
 void RollbackManager::ValidateFrame(Frame newValidateFrame)
@@ -151,7 +195,7 @@ void RollbackManager::ValidateFrame(Frame newValidateFrame)
 #endif
 	const auto lastValidateFrame = gameManager_.GetLastValidateFrame();
 	//We check that we got all the inputs
-	for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB; playerNumber++)
+	for (PlayerNumber playerNumber = 0; playerNumber < gameManager_.GetPlayerNmb(); playerNumber++)
 	{
 		if (GetLastReceivedFrame(playerNumber) < newValidateFrame)
 		{
@@ -162,7 +206,8 @@ void RollbackManager::ValidateFrame(Frame newValidateFrame)
 	//Destroying all created Entities after the last validated frame
 	for (const auto& createdEntity : createdEntities_)
 	{
-		if (createdEntity.createdFrame > lastValidateFrame)
+		if (createdEntity.createdFrame > lastValidateFrame &&
+			entityManager_.IsEntityValid(createdEntity.entity, createdEntity.generation))
 		{
 			entityManager_.DestroyEntity(createdEntity.entity);
 		}
@@ -180,27 +225,13 @@ void RollbackManager::ValidateFrame(Frame newValidateFrame)
 	createdEntities_.clear();
 
 	//We use the current game state as the temporary new validate game state
-	currentPhysicsManager_.CopyAllComponents(lastValidatedPhysicsManager_);
-	currentPlayerManager_.CopyAllComponents(lastValidatedPlayerManager_.GetAllComponents());
-	currentGloveManager_.CopyAllComponents(lastValidatedGloveManager_.GetAllComponents());
+	LoadSnapshot(lastValidatedFrame_);
 
-	//We simulate the frames until the new validated frame
+	//We simulate the frames until the new validated frame, overwriting the predicted snapshots
 	for (Frame frame = lastValidatedFrame_ + 1; frame <= newValidateFrame; frame++)
 	{
-		testedFrame_ = frame;
-		//Copy the players inputs into the player manager
-		for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB; playerNumber++)
-		{
-			const auto playerInput = GetInputAtFrame(playerNumber, frame);
-			const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
-			PlayerCharacter playerCharacter = currentPlayerManager_.GetComponent(playerEntity);
-			playerCharacter.input = playerInput;
-			currentPlayerManager_.SetComponent(playerEntity, playerCharacter);
-		}
-		//We simulate one frame
-		currentPlayerManager_.FixedUpdate(sf::seconds(FIXED_PERIOD));
-		currentGloveManager_.FixedUpdate(sf::seconds(FIXED_PERIOD));
-		currentPhysicsManager_.FixedUpdate(sf::seconds(FIXED_PERIOD));
+		SimulateFrame(frame);
+		SaveSnapshot(frame);
 	}
 	//Definitely remove DESTROY entities
 	for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
@@ -210,77 +241,92 @@ void RollbackManager::ValidateFrame(Frame newValidateFrame)
 			entityManager_.DestroyEntity(entity);
 		}
 	}
-	//Copy back the new validate game state to the last validated game state
-	lastValidatedPlayerManager_.CopyAllComponents(currentPlayerManager_.GetAllComponents());
-	lastValidatedGloveManager_.CopyAllComponents(currentGloveManager_.GetAllComponents());
-	lastValidatedPhysicsManager_.CopyAllComponents(currentPhysicsManager_);
+	//The new validate game state is the snapshot of the new validated frame
+	SaveSnapshot(newValidateFrame);
 	lastValidatedFrame_ = newValidateFrame;
+	validatedPhysicsState_ = ComputePhysicsState();
+	//The predicted snapshots after the validated frame are still usable if no input was corrected before it
+	if (lastSimulatedFrame_ <= newValidateFrame)
+	{
+		lastSimulatedFrame_ = newValidateFrame;
+		firstMispredictedFrame_ = INVALID_FRAME;
+	}
+	else if (firstMispredictedFrame_ <= newValidateFrame)
+	{
+		firstMispredictedFrame_ = newValidateFrame + 1;
+	}
 	createdEntities_.clear();
 }
-void RollbackManager::ConfirmFrame(Frame newValidatedFrame, const std::array<PhysicsState, MAX_PLAYER_NMB>& serverPhysicsState)
+void RollbackManager::ConfirmFrame(Frame newValidatedFrame, const PhysicsState serverPhysicsState)
 {
 
 #ifdef TRACY_ENABLE
 	ZoneScoped;
 #endif
 	ValidateFrame(newValidatedFrame);
-	for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB; playerNumber++)
+	if (serverPhysicsState != validatedPhysicsState_)
 	{
-		const PhysicsState lastPhysicsState = GetValidatePhysicsState(playerNumber);
-		if (serverPhysicsState[playerNumber] != lastPhysicsState)
-		{
-			gpr_assert(false, fmt::format("Physics State are not equal for player {} (server frame: {}, client frame: {}, server: {}, client: {})",
-				playerNumber + 1,
-				newValidatedFrame,
-				lastValidatedFrame_,
-				serverPhysicsState[playerNumber],
-				lastPhysicsState));
-		}
+		gpr_assert(false, fmt::format("Physics State are not equal (server frame: {}, client frame: {}, server: {:016x}, client: {:016x})",
+			newValidatedFrame,
+			lastValidatedFrame_,
+			serverPhysicsState,
+			validatedPhysicsState_));
 	}
 }
-PhysicsState RollbackManager::GetValidatePhysicsState(PlayerNumber playerNumber) const
-{
-	PhysicsState state = 0;
-	const core::Entity playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
-	const std::array<core::Entity, 2> gloveEntities = gameManager_.GetGlovesEntityFromPlayerNumber(playerNumber);
-	const auto& playerBody = lastValidatedPhysicsManager_.GetBody(playerEntity);
-	const std::array<Body, 2>& gloveBodies = { lastValidatedPhysicsManager_.GetBody(gloveEntities[0]),
-		lastValidatedPhysicsManager_.GetBody(gloveEntities[1]) };
-
-	const auto* posPtr = reinterpret_cast<const PhysicsState*>(&playerBody.position);
-	const auto* posPtr2 = reinterpret_cast<const PhysicsState*>(&gloveBodies[0].position);
-	const auto* posPtr3 = reinterpret_cast<const PhysicsState*>(&gloveBodies[1].position);
-	//Adding position
-	for (size_t i = 0; i < sizeof(core::Vec2f) / sizeof(PhysicsState); i++)
-	{
-		state += posPtr[i] + posPtr2[i] + posPtr3[i];
-	}
 
-	//Adding velocity
-	const auto* velocityPtr = reinterpret_cast<const PhysicsState*>(&playerBody.velocity);
-	const auto* velocityPtr2 = reinterpret_cast<const PhysicsState*>(&gloveBodies[0].velocity);
-	const auto* velocityPtr3 = reinterpret_cast<const PhysicsState*>(&gloveBodies[1].velocity);
-	for (size_t i = 0; i < sizeof(core::Vec2f) / sizeof(PhysicsState); i++)
+PhysicsState RollbackManager::ComputePhysicsState() const
+{
+#ifdef TRACY_ENABLE
+	ZoneScoped;
+#endif
+	core::Hash64 hash;
+	const auto addVec2 = [&hash](const Vec2 v)
 	{
-		state += velocityPtr[i] + velocityPtr2[i] + velocityPtr3[i];
-	}
-	//Adding rotation
-	const auto* anglePtr = reinterpret_cast<const PhysicsState*>(&playerBody.rotation);
-	const auto* anglePtr2 = reinterpret_cast<const PhysicsState*>(&gloveBodies[0].rotation);
-	const auto* anglePtr3 = reinterpret_cast<const PhysicsState*>(&gloveBodies[1].rotation);
-	for (size_t i = 0; i < sizeof(float) / sizeof(PhysicsState); i++)
+		hash.Add(v.x);
+		hash.Add(v.y);
+	};
+	const auto addBody = [this, &hash, &addVec2](core::Entity entity)
 	{
-		state += anglePtr[i] + anglePtr2[i] + anglePtr3[i];
-	}
-	//Adding angular Velocity
-	const auto* angularVelPtr = reinterpret_cast<const PhysicsState*>(&playerBody.angularVelocity);
-	const auto* angularVelPtr2 = reinterpret_cast<const PhysicsState*>(&gloveBodies[0].angularVelocity);
-	const auto* angularVelPtr3 = reinterpret_cast<const PhysicsState*>(&gloveBodies[1].angularVelocity);
-	for (size_t i = 0; i < sizeof(float) / sizeof(PhysicsState); i++)
+		const auto& body = currentPhysicsManager_.GetBody(entity);
+		hash.Add(body.mass);
+		addVec2(body.position);
+		addVec2(body.velocity);
+		hash.Add(GetDegrees(body.angularVelocity));
+		hash.Add(GetDegrees(body.rotation));
+		hash.Add(body.bodyType);
+		const auto& col = currentPhysicsManager_.Getcol(entity);
+		hash.Add(col.radius);
+		hash.Add(col.isTrigger);
+		hash.Add(col.enabled);
+	};
+	hash.Add(lastValidatedFrame_);
+	//Walked by player number, the entity indices and the component order can differ between the peers
+	for (PlayerNumber playerNumber = 0; playerNumber < gameManager_.GetPlayerNmb(); playerNumber++)
 	{
-		state += angularVelPtr[i] + angularVelPtr2[i] + angularVelPtr3[i];
+		const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
+		addBody(playerEntity);
+		const auto& playerCharacter = currentPlayerManager_.GetComponent(playerEntity);
+		hash.Add(playerCharacter.knockBackTime);
+		hash.Add(playerCharacter.input);
+		hash.Add(playerCharacter.playerNumber);
+		hash.Add(playerCharacter.damagePercent);
+		hash.Add(playerCharacter.invincibilityTime);
+		for (const auto gloveEntity : gameManager_.GetGlovesEntityFromPlayerNumber(playerNumber))
+		{
+			addBody(gloveEntity);
+			const auto& glove = currentGloveManager_.GetComponent(gloveEntity);
+			hash.Add(glove.playerNumber);
+			hash.Add(glove.sign);
+			hash.Add(glove.punchingTime);
+			hash.Add(glove.recoveryTime);
+			hash.Add(glove.isPunching);
+			hash.Add(glove.isRecovering);
+			hash.Add(glove.hasLaunched);
+			addVec2(glove.velFromPlayer);
+			addVec2(glove.returningFromPos);
+		}
 	}
-	return state;
+	return hash.GetDigest();
 }
 
 void RollbackManager::SpawnPlayer(PlayerNumber playerNumber, core::Entity entity, core::Vec2f position, core::Degree rotation)
@@ -291,8 +337,8 @@ void RollbackManager::SpawnPlayer(PlayerNumber playerNumber, core::Entity entity
 #endif
 	// Define player
 	Body playerBody;
-	playerBody.position = position;
-	playerBody.rotation = rotation;
+	playerBody.position = ToVec2(position);
+	playerBody.rotation = ToAngle(rotation);
 	constexpr Circle playerCol(PLAYER_COL_RADIUS);
 
 	PlayerCharacter playerCharacter;
@@ -307,13 +353,10 @@ void RollbackManager::SpawnPlayer(PlayerNumber playerNumber, core::Entity entity
 	currentPhysicsManager_.AddCol(entity);
 	currentPhysicsManager_.SetCol(entity, playerCol);
 
-	lastValidatedPlayerManager_.AddComponent(entity);
-	lastValidatedPlayerManager_.SetComponent(entity, playerCharacter);
-
-	lastValidatedPhysicsManager_.AddBody(entity);
-	lastValidatedPhysicsManager_.SetBody(entity, playerBody);
-	lastValidatedPhysicsManager_.AddCol(entity);
-	lastValidatedPhysicsManager_.SetCol(entity, playerCol);
+	//Players are spawned before the game starts, so the current world is the validated one
+	SaveSnapshot(lastValidatedFrame_);
+	lastSimulatedFrame_ = lastValidatedFrame_;
+	stateFrame_ = lastValidatedFrame_;
 
 	currentTransformManager_.AddComponent(entity);
 	currentTransformManager_.SetPosition(entity, position);
@@ -328,8 +371,8 @@ void RollbackManager::SpawnGlove(core::Entity playerEntity, core::Entity entity,
 	// Define the glove based on the player
 	Body gloveBody;
 	// Set the glove's position at its ideal location
-	gloveBody.position = position;
-	gloveBody.rotation = rotation;
+	gloveBody.position = ToVec2(position);
+	gloveBody.rotation = ToAngle(rotation);
 	constexpr Circle gloveCol(GLOVE_COL_RADIUS);
 
 	Glove glove;
@@ -345,22 +388,18 @@ void RollbackManager::SpawnGlove(core::Entity playerEntity, core::Entity entity,
 	currentPhysicsManager_.AddCol(entity);
 	currentPhysicsManager_.SetCol(entity, gloveCol);
 
-	lastValidatedGloveManager_.AddComponent(entity);
-	lastValidatedGloveManager_.SetComponent(entity, glove);
-
-	lastValidatedPhysicsManager_.AddBody(entity);
-	lastValidatedPhysicsManager_.SetBody(entity, gloveBody);
-	lastValidatedPhysicsManager_.AddCol(entity);
-	lastValidatedPhysicsManager_.SetCol(entity, gloveCol);
+	SaveSnapshot(lastValidatedFrame_);
+	lastSimulatedFrame_ = lastValidatedFrame_;
+	stateFrame_ = lastValidatedFrame_;
 
 	currentTransformManager_.AddComponent(entity);
-	currentTransformManager_.SetPosition(entity, gloveBody.position);
-	currentTransformManager_.SetRotation(entity, gloveBody.rotation);
+	currentTransformManager_.SetPosition(entity, position);
+	currentTransformManager_.SetRotation(entity, rotation);
 }
 
 void RollbackManager::SpawnEffect(core::Entity entity, core::Vec2f position)
 {
-	createdEntities_.push_back({ entity, testedFrame_ });
+	createdEntities_.push_back({ entity, entityManager_.GetGeneration(entity), testedFrame_ });
 
 	currentTransformManager_.AddComponent(entity);
 	currentTransformManager_.SetPosition(entity, position);
@@ -368,9 +407,51 @@ void RollbackManager::SpawnEffect(core::Entity entity, core::Vec2f position)
 
 PlayerInput RollbackManager::GetInputAtFrame(PlayerNumber playerNumber, Frame frame) const
 {
-	gpr_assert(currentInputFrame_ - frame < inputs_[playerNumber].size(),
-		"Trying to get input too far in the past");
-	return inputs_[playerNumber][currentInputFrame_ - frame];
+	return inputs_[playerNumber].GetInput(frame);
+}
+
+void RollbackManager::SimulateFrame(Frame frame)
+{
+	testedFrame_ = frame;
+	//Copy player inputs to player manager
+	for (PlayerNumber playerNumber = 0; playerNumber < gameManager_.GetPlayerNmb(); playerNumber++)
+	{
+		const auto playerInput = GetInputAtFrame(playerNumber, frame);
+		const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
+		if (playerEntity == core::INVALID_ENTITY)
+		{
+			core::LogWarning(fmt::format("Invalid Entity in {}:line {}", __FILE__, __LINE__));
+			continue;
+		}
+		PlayerCharacter playerCharacter = currentPlayerManager_.GetComponent(playerEntity);
+		playerCharacter.input = playerInput;
+		currentPlayerManager_.SetComponent(playerEntity, playerCharacter);
+	}
+	//Simulate one frame of the game
+	currentPlayerManager_.FixedUpdate(sf::seconds(FIXED_PERIOD));
+	currentGloveManager_.FixedUpdate(sf::seconds(FIXED_PERIOD));
+	currentPhysicsManager_.FixedUpdate(sf::seconds(FIXED_PERIOD));
+	stateFrame_ = frame;
+}
+
+void RollbackManager::SaveSnapshot(Frame frame)
+{
+	auto& snapshot = snapshots_[frame % WINDOW_BUFFER_SIZE];
+	snapshot.frame = frame;
+	snapshot.bodies = currentPhysicsManager_.GetAllBodies();
+	snapshot.cols = currentPhysicsManager_.GetAllCols();
+	snapshot.playerCharacters = currentPlayerManager_.GetAllComponents();
+	snapshot.gloves = currentGloveManager_.GetAllComponents();
+}
+
+void RollbackManager::LoadSnapshot(Frame frame)
+{
+	const auto& snapshot = snapshots_[frame % WINDOW_BUFFER_SIZE];
+	gpr_assert(snapshot.frame == frame, "Trying to load a snapshot too far in the past");
+	currentPhysicsManager_.CopyAllComponents(snapshot.bodies, snapshot.cols);
+	currentPlayerManager_.CopyAllComponents(snapshot.playerCharacters);
+	currentGloveManager_.CopyAllComponents(snapshot.gloves);
+	stateFrame_ = frame;
 }
 
 void RollbackManager::OnTrigger(core::Entity entity1, core::Entity entity2)
@@ -400,9 +481,10 @@ void RollbackManager::DestroyEntity(core::Entity entity)
 	ZoneScoped;
 #endif
 	//we don't need to save a bullet that has been created in the time window
-	if (std::find_if(createdEntities_.begin(), createdEntities_.end(), [entity](auto newEntity)
+	const auto generation = entityManager_.GetGeneration(entity);
+	if (std::find_if(createdEntities_.begin(), createdEntities_.end(), [entity, generation](auto newEntity)
 		{
-			return newEntity.entity == entity;
+			return newEntity.entity == entity && newEntity.generation == generation;
 		}) != createdEntities_.end())
 	{
 		entityManager_.DestroyEntity(entity);
@@ -440,7 +522,7 @@ void RollbackManager::ManagePGCollision(auto playerEntity, auto gloveEntity)
 
 	if (!reSimulating_)
 	{
-		gameManager_.SpawnEffect(EffectType::HIT_BIG, (gloveBody.position + playerBody.position) / 2.0f);
+		gameManager_.SpawnEffect(EffectType::HIT_BIG, ToVec2f((gloveBody.position + playerBody.position) / 2.0f));
 	}
 }
 
@@ -477,8 +559,8 @@ void RollbackManager::ManageGGCollision(auto firstGloveEntity, auto secondGloveE
 	if (bothPunch)
 	{
 		// Zero out
-		glove1Body.velocity = core::Vec2f::zero();
-		glove2Body.velocity = core::Vec2f::zero();
+		glove1Body.velocity = Vec2::zero();
+		glove2Body.velocity = Vec2::zero();
 
 		currentPhysicsManager_.SetBody(firstGloveEntity, glove1Body);
 		currentPhysicsManager_.SetBody(secondGloveEntity, glove2Body);
@@ -486,7 +568,7 @@ void RollbackManager::ManageGGCollision(auto firstGloveEntity, auto secondGloveE
 
 	if (!reSimulating_)
 	{
-		gameManager_.SpawnEffect(EffectType::HIT, (glove1Body.position + glove2Body.position) / 2.0f);
+		gameManager_.SpawnEffect(EffectType::HIT, ToVec2f((glove1Body.position + glove2Body.position) / 2.0f));
 	}
 }
 
@@ -495,7 +577,7 @@ void RollbackManager::HandlePunchCollision(Body gloveBody, core::Entity gloveEnt
 {
 	otherBody.velocity = gloveBody.velocity.GetNormalized() * mod;
 
-	gloveBody.velocity = core::Vec2f::zero();
+	gloveBody.velocity = Vec2::zero();
 
 	currentPhysicsManager_.SetBody(gloveEntity, gloveBody);
 	currentPhysicsManager_.SetBody(otherEntity, otherBody);
@@ -43,56 +43,21 @@ void Client::ReceivePacket(const Packet* packet)
             system_clock::now().time_since_epoch()
             ) + milliseconds(START_DELAY)).count() - milliseconds(static_cast<long long>(currentPing_)).count();
 
+        gameManager_.SetPlayerNmb(static_cast<const StartGamePacket*>(packet)->playerNmb);
         gameManager_.StartGame(startingTime);
         break;
     }
     case PacketType::INPUT:
     {
-        const auto* playerInputPacket = static_cast<const PlayerInputPacket*>(packet);
-        const auto playerNumber = playerInputPacket->playerNumber;
-        const auto inputFrame = core::ConvertFromBinary<Frame>(playerInputPacket->currentFrame);
-
-        if (playerNumber == gameManager_.GetPlayerNumber())
-        {
-            //Verify the inputs coming back from the server
-            const auto& inputs = gameManager_.GetRollbackManager().GetInputs(playerNumber);
-            const auto currentFrame = gameManager_.GetRollbackManager().GetCurrentInputFrame();
-            
-            for (size_t i = 0; i < playerInputPacket->inputs.size(); i++)
-            {
-                const auto index = currentFrame - inputFrame + i;
-                if (index > inputs.size())
-                {
-                    break;
-                }
-                if (inputs[index] != playerInputPacket->inputs[i])
-                {
-                    core::LogWarning("INPUT DOESN'T MATCH");
-                    //gpr_assert(false, "Inputs coming back from server are not coherent!!!");
-                }
-                if (inputFrame - i == 0)
-                {
-                    break;
-                }
-            }
-            break;
-        }
-
-        //discard delayed input packet
-        if (inputFrame < gameManager_.GetRollbackManager().GetLastReceivedFrame(playerNumber))
-        {
-            break;
-        }
-        for (Frame i = 0; i < playerInputPacket->inputs.size(); i++)
+        ReceivePlayerInput(*static_cast<const PlayerInputPacket*>(packet));
+        break;
+    }
+    case PacketType::MULTI_INPUT:
+    {
+        const auto* multiInputPacket = static_cast<const MultiInputPacket*>(packet);
+        for (std::uint8_t i = 0; i < multiInputPacket->playerInputNmb; i++)
         {
-            gameManager_.SetPlayerInput(playerNumber,
-                playerInputPacket->inputs[i],
-                inputFrame - i);
-
-            if (inputFrame - i == 0)
-            {
-                break;
-            }
+            ReceivePlayerInput(multiInputPacket->playerInputs[i]);
         }
         break;
     }
@@ -100,13 +65,14 @@ void Client::ReceivePacket(const Packet* packet)
     {
         const auto* validateFramePacket = static_cast<const ValidateFramePacket*>(packet);
         const auto newValidateFrame = core::ConvertFromBinary<Frame>(validateFramePacket->newValidateFrame);
-        std::array<PhysicsState, MAX_PLAYER_NMB> physicsStates{};
-        for (size_t i = 0; i < validateFramePacket->physicsState.size(); i++)
+        const auto physicsState = core::ConvertFromBinary<PhysicsState>(validateFramePacket->physicsState);
+        gameManager_.ConfirmValidateFrame(newValidateFrame, physicsState);
+        const auto playerNumber = gameManager_.GetPlayerNumber();
+        if (playerNumber < validateFramePacket->inputAckNmb)
         {
-            auto* statePtr = reinterpret_cast<std::uint8_t*>(physicsStates.data());
-            statePtr[i] = validateFramePacket->physicsState[i];
+            gameManager_.AcknowledgeInputs(
+                core::ConvertFromBinary<Frame>(validateFramePacket->inputAckFrames[playerNumber]));
         }
-        gameManager_.ConfirmValidateFrame(newValidateFrame, physicsStates);
         //logDebug("Client received validate frame " + std::to_string(newValidateFrame));
         break;
     }
@@ -164,13 +130,73 @@ void Client::Update(sf::Time dt)
         if (clientId_ != INVALID_CLIENT_ID)
         {
             using namespace std::chrono;
-            auto pingPacket = std::make_unique<PingPacket>();
-            pingPacket->time = core::ConvertToBinary(duration_cast<duration<unsigned long long, std::milli>>(
+            PingPacket pingPacket;
+            pingPacket.time = core::ConvertToBinary(duration_cast<duration<unsigned long long, std::milli>>(
                 system_clock::now().time_since_epoch()).count());
-            pingPacket->clientId = core::ConvertToBinary(clientId_);
-            SendUnreliablePacket(std::move(pingPacket));
+            pingPacket.clientId = core::ConvertToBinary(clientId_);
+            SendUnreliablePacket(pingPacket);
         }
         pingTimer_ = pingPeriod_;
     }
 }
+
+void Client::ReceivePlayerInput(const PlayerInputPacket& playerInputPacket)
+{
+    const auto playerNumber = playerInputPacket.playerNumber;
+    //The input buffers are indexed by player number
+    if (playerNumber >= gameManager_.GetPlayerNmb())
+    {
+        return;
+    }
+    const auto inputFrame = core::ConvertFromBinary<Frame>(playerInputPacket.currentFrame);
+
+    if (playerNumber == gameManager_.GetPlayerNumber())
+    {
+        //Verify the inputs coming back from the server
+        const auto& rollbackManager = gameManager_.GetRollbackManager();
+        const auto lastReceivedFrame = rollbackManager.GetLastReceivedFrame(playerNumber);
+
+        for (Frame i = 0; i < playerInputPacket.inputNmb; i++)
+        {
+            const auto frame = inputFrame - i;
+            if (frame > lastReceivedFrame || lastReceivedFrame - frame >= WINDOW_BUFFER_SIZE)
+            {
+                break;
+            }
+            if (rollbackManager.GetInputAtFrame(playerNumber, frame) != playerInputPacket.inputs[i])
+            {
+                core::LogWarning("INPUT DOESN'T MATCH");
+                //gpr_assert(false, "Inputs coming back from server are not coherent!!!");
+            }
+            if (inputFrame - i == 0)
+            {
+                break;
+            }
+        }
+        return;
+    }
+
+    //discard delayed input packet
+    if (inputFrame < gameManager_.GetRollbackManager().GetLastReceivedFrame(playerNumber))
+    {
+        return;
+    }
+    const auto& rollbackManager = gameManager_.GetRollbackManager();
+    for (Frame i = 0; i < playerInputPacket.inputNmb; i++)
+    {
+        const auto frame = inputFrame - i;
+        //Already received inputs are skipped, only predicted ones need to be replaced
+        if (!rollbackManager.IsInputConfirmed(playerNumber, frame))
+        {
+            gameManager_.SetPlayerInput(playerNumber,
+                playerInputPacket.inputs[i],
+                frame);
+        }
+
+        if (frame == 0)
+        {
+            break;
+        }
+    }
+}
 }
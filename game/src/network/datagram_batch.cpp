@@ -0,0 +1,153 @@
+#include <network/datagram_batch.h>
+#include "network/socket_handle.h"
+#include "utils/log.h"
+
+#include <fmt/format.h>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+DatagramBatch::DatagramBatch(sf::UdpSocket& udpSocket) :
+    udpSocket_(udpSocket), receiveBuffers_(MAX_DATAGRAM_BATCH)
+{
+}
+
+std::size_t DatagramBatch::Receive()
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+#ifdef __linux__
+    std::size_t datagramNmb = 0;
+    //A batch made only of truncated datagrams must not be mistaken for an empty socket, so the next batch is read
+    while (datagramNmb == 0)
+    {
+        for (std::size_t i = 0; i < MAX_DATAGRAM_BATCH; i++)
+        {
+            iovecs_[i].iov_base = receiveBuffers_[i].data();
+            iovecs_[i].iov_len = MAX_DATAGRAM_SIZE;
+            messages_[i].msg_hdr = {};
+            messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+            messages_[i].msg_hdr.msg_iovlen = 1;
+            messages_[i].msg_hdr.msg_name = &addresses_[i];
+            messages_[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        }
+        const int messageNmb = recvmmsg(GetSocketHandle(udpSocket_), messages_.data(),
+            static_cast<unsigned>(MAX_DATAGRAM_BATCH), MSG_DONTWAIT, nullptr);
+        if (messageNmb <= 0)
+        {
+            return 0;
+        }
+        for (int i = 0; i < messageNmb; i++)
+        {
+            if (messages_[i].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                core::LogWarning(fmt::format("[Network] Dropping a datagram longer than {} bytes", MAX_DATAGRAM_SIZE));
+                continue;
+            }
+            auto& datagram = receivedDatagrams_[datagramNmb];
+            datagram.data = receiveBuffers_[i].data();
+            datagram.size = messages_[i].msg_len;
+            datagram.address = sf::IpAddress(ntohl(addresses_[i].sin_addr.s_addr));
+            datagram.port = ntohs(addresses_[i].sin_port);
+            datagramNmb++;
+        }
+    }
+    return datagramNmb;
+#else
+    std::size_t datagramNmb = 0;
+    while (datagramNmb < MAX_DATAGRAM_BATCH)
+    {
+        auto& datagram = receivedDatagrams_[datagramNmb];
+        std::size_t received = 0;
+        if (udpSocket_.receive(receiveBuffers_[datagramNmb].data(), MAX_DATAGRAM_SIZE, received,
+            datagram.address, datagram.port) != sf::Socket::Done)
+        {
+            break;
+        }
+        datagram.data = receiveBuffers_[datagramNmb].data();
+        datagram.size = received;
+        datagramNmb++;
+    }
+    return datagramNmb;
+#endif
+}
+
+DatagramBatch::PayloadId DatagramBatch::AddPayload(const sf::Packet& packet)
+{
+    return AddPayload(static_cast<const char*>(packet.getData()), packet.getDataSize());
+}
+
+DatagramBatch::PayloadId DatagramBatch::AddPayload(const char* data, std::size_t size)
+{
+    payloads_.push_back({ payloadBuffer_.size(), size });
+    payloadBuffer_.insert(payloadBuffer_.end(), data, data + size);
+    return payloads_.size() - 1;
+}
+
+void DatagramBatch::QueueSend(PayloadId payloadId, sf::IpAddress address, unsigned short port)
+{
+    queuedDatagrams_.push_back({ payloadId, address, port });
+}
+
+void DatagramBatch::Flush()
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+#ifdef __linux__
+    for (std::size_t first = 0; first < queuedDatagrams_.size();)
+    {
+        const auto batchSize = std::min(MAX_DATAGRAM_BATCH, queuedDatagrams_.size() - first);
+        for (std::size_t i = 0; i < batchSize; i++)
+        {
+            const auto& queuedDatagram = queuedDatagrams_[first + i];
+            const auto& payload = payloads_[queuedDatagram.payloadId];
+            addresses_[i] = {};
+            addresses_[i].sin_family = AF_INET;
+            addresses_[i].sin_addr.s_addr = htonl(queuedDatagram.address.toInteger());
+            addresses_[i].sin_port = htons(queuedDatagram.port);
+            iovecs_[i].iov_base = payloadBuffer_.data() + payload.offset;
+            iovecs_[i].iov_len = payload.size;
+            messages_[i].msg_hdr = {};
+            messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+            messages_[i].msg_hdr.msg_iovlen = 1;
+            messages_[i].msg_hdr.msg_name = &addresses_[i];
+            messages_[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        }
+        const int sentNmb = sendmmsg(GetSocketHandle(udpSocket_), messages_.data(),
+            static_cast<unsigned>(batchSize), MSG_DONTWAIT);
+        if (sentNmb <= 0)
+        {
+            //The datagram that failed is dropped, like an unreliable packet lost on the way
+            core::LogDebug(fmt::format("[Network] Error while sending UDP datagrams: {}", std::strerror(errno)));
+            first++;
+            continue;
+        }
+        first += static_cast<std::size_t>(sentNmb);
+    }
+#else
+    for (const auto& queuedDatagram : queuedDatagrams_)
+    {
+        const auto& payload = payloads_[queuedDatagram.payloadId];
+        if (udpSocket_.send(payloadBuffer_.data() + payload.offset, payload.size,
+            queuedDatagram.address, queuedDatagram.port) != sf::Socket::Done)
+        {
+            core::LogDebug("[Network] Error while sending UDP datagram");
+        }
+    }
+#endif
+    queuedDatagrams_.clear();
+    payloads_.clear();
+    payloadBuffer_.clear();
+}
+}
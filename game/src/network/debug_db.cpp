@@ -13,38 +13,57 @@
 #include <Tracy.hpp>
 #endif
 
+#include <chrono>
 #include <filesystem>
+#include <string>
 
 namespace fs = std::filesystem;
 
 
 namespace game
 {
+/**
+ * \brief The writer thread wakes up at this period to insert the records stored in the meantime.
+ */
+static constexpr auto DB_WRITE_PERIOD = std::chrono::milliseconds(50);
 
-static int callback([[maybe_unused]] void* NotUsed, int argc, char** argv, char** azColName)
+DebugDatabase::~DebugDatabase()
 {
-    for (int i = 0; i < argc; i++) {
-        core::LogDebug(fmt::format("{} = {}", azColName[i], argv[i] ? argv[i] : "NULL"));
-    }
-    return 0;
+    Close();
 }
 
 void DebugDatabase::Open(std::string_view path)
 {
-    if (fs::exists(path))
+    const std::string pathStr(path);
+    if (fs::exists(pathStr))
     {
-        fs::remove(path);
+        fs::remove(pathStr);
     }
-    const auto rc = sqlite3_open(path.data(), &db);
+    const auto rc = sqlite3_open(pathStr.c_str(), &db);
     if (rc != SQLITE_OK)
     {
         core::LogError(fmt::format("Can't open database: {}\n", sqlite3_errmsg(db)));
         sqlite3_close(db);
         db = nullptr;
+        return;
     }
+    //The writer thread is the only connection, the WAL journal makes its commits cheap
+    Execute("PRAGMA journal_mode=WAL;");
+    Execute("PRAGMA synchronous=NORMAL;");
     CreateTables();
+    sqlite3_prepare_v2(db,
+        "INSERT INTO inputs (player_number, frame, up, down, left, right, punch, punch2) VALUES(?, ?, ?, ?, ?, ?, ?, ?);",
+        -1, &insertInputStatement_, nullptr);
+    sqlite3_prepare_v2(db,
+        "INSERT INTO physics_state (local_frame, validate_frame, state_local, state_server) VALUES (?, ?, ?, ?);",
+        -1, &insertPhysicsStateStatement_, nullptr);
+    if (insertInputStatement_ == nullptr || insertPhysicsStateStatement_ == nullptr)
+    {
+        core::LogError(fmt::format("SQL error while preparing statements: {}", sqlite3_errmsg(db)));
+    }
+    isOver_.store(false, std::memory_order_release);
+    droppedRecordNmb_ = 0;
     t_ = std::thread{ &DebugDatabase::Loop, this };
-    t_.detach();
 }
 
 void DebugDatabase::StorePacket(const PlayerInputPacket* inputPacket)
@@ -52,25 +71,19 @@ void DebugDatabase::StorePacket(const PlayerInputPacket* inputPacket)
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    const PlayerNumber playerNumber = inputPacket->playerNumber;
-    const auto frame = core::ConvertFromBinary<Frame>(inputPacket->currentFrame);
-    const PlayerInput input = inputPacket->inputs[0];
-
-    auto query = fmt::format("INSERT INTO inputs (player_number, frame, up, down, left, right, shoot) VALUES({}, {}, {}, {}, {}, {},  {});",
-        playerNumber,
-        frame,
-        (input & PlayerInputEnum::UP) == PlayerInputEnum::UP,
-        (input & PlayerInputEnum::DOWN) == PlayerInputEnum::DOWN,
-        (input & PlayerInputEnum::LEFT) == PlayerInputEnum::LEFT,
-        (input & PlayerInputEnum::RIGHT) == PlayerInputEnum::RIGHT,
-        (input & PlayerInputEnum::SHOOT) == PlayerInputEnum::SHOOT);
-
+    //A short packet decodes to no input, there is nothing to record for its frame
+    if (inputPacket->inputNmb == 0)
     {
-        std::lock_guard lock(m_);
-        commands_.push_back(query);
+        return;
+    }
+    DbInput dbInput;
+    dbInput.playerNumber = inputPacket->playerNumber;
+    dbInput.frame = core::ConvertFromBinary<Frame>(inputPacket->currentFrame);
+    dbInput.input = inputPacket->inputs[0];
+    if (!records_.TryPush(dbInput))
+    {
+        droppedRecordNmb_++;
     }
-
-    cv_.notify_one();
 }
 
 void DebugDatabase::StorePhysicsState(const DbPhysicsState& physicsState)
@@ -78,30 +91,32 @@ void DebugDatabase::StorePhysicsState(const DbPhysicsState& physicsState)
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-
-    std::string query = "INSERT INTO physics_state (local_frame, validate_frame ";
-    std::string arguments;
-    std::string values = fmt::format(" VALUES ({}, {}", physicsState.lastLocalValidateFrame, physicsState.validateFrame);
-    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
-    {
-        arguments += fmt::format(",state_p{}_local, state_p{}_server ", playerNumber + 1, playerNumber + 1);
-        values += fmt::format(",{},{}", physicsState.localStates[playerNumber], physicsState.serverStates[playerNumber]);
-    }
-    query += arguments + ") " + values + " );";
+    if (!records_.TryPush(physicsState))
     {
-        std::lock_guard lock(m_);
-        commands_.push_back(query);
+        droppedRecordNmb_++;
     }
-
-    cv_.notify_one();
 }
 
 void DebugDatabase::Close()
 {
-    isOver_.store(true, std::memory_order_release);
-    cv_.notify_one();
-
-    //t_.join();
+    if (t_.joinable())
+    {
+        {
+            std::lock_guard lock(m_);
+            isOver_.store(true, std::memory_order_release);
+        }
+        cv_.notify_one();
+        t_.join();
+    }
+    if (droppedRecordNmb_ > 0)
+    {
+        core::LogWarning(fmt::format("[DebugDatabase] {} records were dropped, the ring was full", droppedRecordNmb_));
+        droppedRecordNmb_ = 0;
+    }
+    sqlite3_finalize(insertInputStatement_);
+    insertInputStatement_ = nullptr;
+    sqlite3_finalize(insertPhysicsStateStatement_);
+    insertPhysicsStateStatement_ = nullptr;
     if (db != nullptr)
     {
         sqlite3_close(db);
@@ -111,42 +126,80 @@ void DebugDatabase::Close()
 
 void DebugDatabase::Loop()
 {
-    std::unique_lock lock(m_);
-    while (!isOver_.load(std::memory_order_acquire))
+    while (true)
     {
-        while (!commands_.empty())
+        //The records pushed before Close are in the ring when isOver_ is seen, they are written by the last batch
+        const bool isOver = isOver_.load(std::memory_order_acquire);
+        WriteBatch();
+        if (isOver)
         {
-            if (isOver_.load(std::memory_order_acquire))
-            {
-                break;
-            }
+            break;
+        }
+        std::unique_lock lock(m_);
+        cv_.wait_for(lock, DB_WRITE_PERIOD, [this] { return isOver_.load(std::memory_order_acquire); });
+    }
+}
+
+void DebugDatabase::WriteBatch()
+{
+    if (records_.IsEmpty() || insertInputStatement_ == nullptr || insertPhysicsStateStatement_ == nullptr)
+    {
+        return;
+    }
 #ifdef TRACY_ENABLE
-            ZoneNamedN(sqlExecuteCommand, "SQL Execute Command", true);
+    ZoneNamedN(sqlWriteBatch, "SQL Write Batch", true);
 #endif
-            std::string command = std::move(commands_[0]);
-            commands_.erase(commands_.begin());
-            lock.unlock();
-            /* Execute SQL statement */
-
-            char* zErrMsg = nullptr;
-            const auto rc = sqlite3_exec(db, command.c_str(), callback, nullptr, &zErrMsg);
-
-            if (rc != SQLITE_OK) {
-                core::LogError(fmt::format("SQL error with storing input: {}", zErrMsg));
-                sqlite3_free(zErrMsg);
-            }
-            lock.lock();
+    Execute("BEGIN TRANSACTION;");
+    Record record;
+    //Bounded, so that a producer faster than the writer does not keep the transaction open forever
+    for (std::size_t i = 0; i < DB_RECORD_RING_SIZE && records_.TryPop(record); i++)
+    {
+        sqlite3_stmt* statement = nullptr;
+        if (const auto* dbInput = std::get_if<DbInput>(&record))
+        {
+            statement = insertInputStatement_;
+            const auto input = dbInput->input;
+            sqlite3_bind_int(statement, 1, dbInput->playerNumber);
+            sqlite3_bind_int64(statement, 2, dbInput->frame);
+            sqlite3_bind_int(statement, 3, (input & PlayerInputEnum::UP) == PlayerInputEnum::UP);
+            sqlite3_bind_int(statement, 4, (input & PlayerInputEnum::DOWN) == PlayerInputEnum::DOWN);
+            sqlite3_bind_int(statement, 5, (input & PlayerInputEnum::LEFT) == PlayerInputEnum::LEFT);
+            sqlite3_bind_int(statement, 6, (input & PlayerInputEnum::RIGHT) == PlayerInputEnum::RIGHT);
+            sqlite3_bind_int(statement, 7, (input & PlayerInputEnum::PUNCH) == PlayerInputEnum::PUNCH);
+            sqlite3_bind_int(statement, 8, (input & PlayerInputEnum::PUNCH2) == PlayerInputEnum::PUNCH2);
         }
-        if (isOver_.load(std::memory_order_acquire))
-            break;
-        cv_.wait(lock);
+        else
+        {
+            statement = insertPhysicsStateStatement_;
+            const auto& physicsState = std::get<DbPhysicsState>(record);
+            sqlite3_bind_int64(statement, 1, physicsState.lastLocalValidateFrame);
+            sqlite3_bind_int64(statement, 2, physicsState.validateFrame);
+            //SQLite integers are signed 64-bit, the hashes are stored with the same bits
+            sqlite3_bind_int64(statement, 3, static_cast<sqlite3_int64>(physicsState.localState));
+            sqlite3_bind_int64(statement, 4, static_cast<sqlite3_int64>(physicsState.serverState));
+        }
+        if (sqlite3_step(statement) != SQLITE_DONE)
+        {
+            core::LogError(fmt::format("SQL error with storing record: {}", sqlite3_errmsg(db)));
+        }
+        sqlite3_reset(statement);
+    }
+    Execute("COMMIT;");
+}
+
+void DebugDatabase::Execute(const char* sql) const
+{
+    char* zErrMsg = nullptr;
+    const auto rc = sqlite3_exec(db, sql, nullptr, nullptr, &zErrMsg);
+    if (rc != SQLITE_OK) {
+        core::LogError(fmt::format("SQL error with {}: {}", sql, zErrMsg));
+        sqlite3_free(zErrMsg);
     }
-    isOver_ = false;
 }
 
 void DebugDatabase::CreateTables() const
 {
-    //playerNumber, frame, up, down, left, right, shoot
+    //playerNumber, frame, up, down, left, right, punch, punch2
 
     const auto createInputTable = "CREATE TABLE inputs ("\
         "input_id INTEGER PRIMARY KEY,"\
@@ -156,35 +209,18 @@ void DebugDatabase::CreateTables() const
         "down INTEGER NOT NULL,"\
         "left INTEGER NOT NULL,"\
         "right INTEGER NOT NULL,"\
-        "shoot INTEGER NOT NULL);";
-
-    /* Execute SQL statement */
-
-    char* zErrMsg = nullptr;
-    const auto rc = sqlite3_exec(db, createInputTable, callback, nullptr, &zErrMsg);
+        "punch INTEGER NOT NULL,"\
+        "punch2 INTEGER NOT NULL);";
+    Execute(createInputTable);
 
-    if (rc != SQLITE_OK) {
-        core::LogError(fmt::format("SQL error while creating table: {}", zErrMsg));
-        sqlite3_free(zErrMsg);
-    }
-
-    std::string createPhysicsStateTable = "CREATE TABLE physics_state ("\
+    const auto createPhysicsStateTable = "CREATE TABLE physics_state ("\
         "phys_id INTEGER PRIMARY KEY,"\
         "local_frame INTEGER NOT NULL,"\
-        "validate_frame INTEGER NOT NULL"\
-        ;
-    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
-    {
-        createPhysicsStateTable += fmt::format(",state_p{}_local INTEGER NOT NULL, state_p{}_server INTEGER NOT NULL", playerNumber + 1, playerNumber + 1);
-    }
-    createPhysicsStateTable += ");";
-    zErrMsg = nullptr;
-    const auto rc2 = sqlite3_exec(db, createPhysicsStateTable.data(), callback, nullptr, &zErrMsg);
-    if (rc2 != SQLITE_OK) {
-        core::LogError(fmt::format("SQL error while creating table: {}", zErrMsg));
-        sqlite3_free(zErrMsg);
-    }
+        "validate_frame INTEGER NOT NULL,"\
+        "state_local INTEGER NOT NULL,"\
+        "state_server INTEGER NOT NULL);";
+    Execute(createPhysicsStateTable);
 }
 }
 
-#endif
\ No newline at end of file
+#endif
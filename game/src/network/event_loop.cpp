@@ -0,0 +1,107 @@
+#include <network/event_loop.h>
+#include "network/socket_handle.h"
+#include "utils/log.h"
+
+#include <fmt/format.h>
+#include <algorithm>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#endif
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+EventLoop::EventLoop() : timerWheel_(sf::milliseconds(1))
+{
+#ifdef __linux__
+    //epoll_wait needs room for at least one event
+    events_.resize(1);
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd_ < 0)
+    {
+        core::LogError(fmt::format("[EventLoop] Could not create epoll: {}", std::strerror(errno)));
+    }
+#endif
+}
+
+EventLoop::~EventLoop()
+{
+#ifdef __linux__
+    if (epollFd_ >= 0)
+    {
+        close(epollFd_);
+    }
+#endif
+}
+
+void EventLoop::Add(sf::Socket& socket)
+{
+#ifdef __linux__
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = &socket;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, GetSocketHandle(socket), &event) < 0)
+    {
+        core::LogError(fmt::format("[EventLoop] Could not add socket to epoll: {}", std::strerror(errno)));
+        return;
+    }
+    events_.resize(events_.size() + 1);
+#else
+    selector_.add(socket);
+    sockets_.push_back(&socket);
+#endif
+}
+
+void EventLoop::Remove(sf::Socket& socket)
+{
+#ifdef __linux__
+    if (epoll_ctl(epollFd_, EPOLL_CTL_DEL, GetSocketHandle(socket), nullptr) == 0 && events_.size() > 1)
+    {
+        events_.pop_back();
+    }
+#else
+    selector_.remove(socket);
+    sockets_.erase(std::remove(sockets_.begin(), sockets_.end(), &socket), sockets_.end());
+#endif
+    //A socket removed while the ready sockets are processed must not be read anymore
+    std::replace(readySockets_.begin(), readySockets_.end(), &socket, static_cast<sf::Socket*>(nullptr));
+}
+
+const std::vector<sf::Socket*>& EventLoop::Wait()
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    readySockets_.clear();
+    const auto timeout = timerWheel_.GetTimeUntilNextTimer();
+#ifdef __linux__
+    //Round up, waking up before the timer is due would spin
+    const int timeoutMs = timeout.asMicroseconds() < 0 ? -1 :
+        static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+    const int eventNmb = epoll_wait(epollFd_, events_.data(), static_cast<int>(events_.size()), timeoutMs);
+    for (int i = 0; i < eventNmb; i++)
+    {
+        readySockets_.push_back(static_cast<sf::Socket*>(events_[i].data.ptr));
+    }
+#else
+    if (selector_.wait(timeout.asMicroseconds() < 0 ? sf::Time() : timeout))
+    {
+        for (auto* socket : sockets_)
+        {
+            if (selector_.isReady(*socket))
+            {
+                readySockets_.push_back(socket);
+            }
+        }
+    }
+#endif
+    timerWheel_.Advance(clock_.restart());
+    return readySockets_;
+}
+}
@@ -0,0 +1,462 @@
+#include <network/match_server.h>
+#include "utils/log.h"
+#include "utils/conversion.h"
+#include "utils/assert.h"
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+Match::Match(unsigned short udpPort) : udpPort_(udpPort)
+{
+}
+
+void Match::SendReliablePacket(const Packet& packet)
+{
+    GeneratePacket(AddSentPacket(true).packet, packet);
+}
+
+void Match::SendUnreliablePacket(const Packet& packet)
+{
+    GenerateUnreliableDatagram(AddSentPacket(false).packet, packet);
+}
+
+Match::SentPacket& Match::AddSentPacket(bool reliable)
+{
+    if (sentPacketNmb_ == sentPackets_.size())
+    {
+        sentPackets_.emplace_back();
+    }
+    auto& sentPacket = sentPackets_[sentPacketNmb_];
+    sentPacketNmb_++;
+    sentPacket.packet.clear();
+    sentPacket.reliable = reliable;
+    return sentPacket;
+}
+
+void Match::Begin()
+{
+    isSpectated_ = true;
+}
+
+void Match::Update(sf::Time dt)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    for (const auto& receivedPacket : receivedPackets_)
+    {
+        const auto& packet = GetPacket(receivedPacket);
+        Server::ReceivePacket(packet);
+        if (packet.packetType != PacketType::JOIN)
+        {
+            continue;
+        }
+
+        JoinAckPacket joinAckPacket;
+        joinAckPacket.clientId = static_cast<const JoinPacket&>(packet).clientId;
+        joinAckPacket.udpPort = core::ConvertToBinary(udpPort_);
+        SendReliablePacket(joinAckPacket);
+    }
+    receivedPackets_.clear();
+    UpdateInputBroadcast(dt.asSeconds());
+}
+
+void Match::End()
+{
+}
+
+void Match::PushReceivedPacket(const PacketVariant& packet)
+{
+    receivedPackets_.push_back(packet);
+}
+
+void Match::SpawnNewPlayer([[maybe_unused]] ClientId clientId, [[maybe_unused]] PlayerNumber newPlayerNumber)
+{
+    //The new client also needs the players that joined before it
+    for (PlayerNumber p = 0; p <= lastPlayerNumber_; p++)
+    {
+        SpawnPlayerPacket spawnPlayer;
+        spawnPlayer.clientId = core::ConvertToBinary(clientMap_[p]);
+        spawnPlayer.playerNumber = p;
+
+        const auto pos = SPAWN_POSITIONS[p] * 3.0f;
+        spawnPlayer.pos = ConvertToBinary(pos);
+
+        const auto rotation = SPAWN_ROTATIONS[p];
+        spawnPlayer.angle = core::ConvertToBinary(rotation);
+        gameManager_.SpawnPlayer(p, pos, rotation);
+        gameManager_.SpawnGloves(p, pos, rotation);
+
+        SendReliablePacket(spawnPlayer);
+    }
+}
+
+MatchServer::MatchServer(std::size_t workerNmb) : threadPool_(workerNmb)
+{
+}
+
+void MatchServer::Begin()
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    sf::Socket::Status status = sf::Socket::Error;
+    while (status != sf::Socket::Done)
+    {
+        status = udpSocket_.bind(udpPort_);
+        if (status != sf::Socket::Done)
+        {
+            udpPort_++;
+        }
+    }
+    udpSocket_.setBlocking(false);
+    core::LogDebug(fmt::format("[MatchServer] Udp Socket on port: {}, {} worker threads",
+        udpPort_, threadPool_.GetWorkerNmb()));
+
+    eventLoop_.Add(udpSocket_);
+    //The fixed tick wakes the loop up at the game rate, so Update keeps being called without traffic
+    eventLoop_.GetTimerWheel().Schedule(sf::seconds(FIXED_PERIOD), [] {}, sf::seconds(FIXED_PERIOD));
+
+    isOpen_ = true;
+}
+
+void MatchServer::Update(sf::Time dt)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    for (auto* socket : eventLoop_.Wait())
+    {
+        if (socket == &udpSocket_)
+        {
+            ReceiveUdpPackets();
+        }
+    }
+
+    updatedMatches_.clear();
+    for (auto& [matchId, hostedMatch] : matches_)
+    {
+        if (hostedMatch.match->HasReceivedPackets())
+        {
+            updatedMatches_.push_back(hostedMatch.match.get());
+        }
+    }
+    threadPool_.ParallelFor(updatedMatches_.size(), [this, dt](std::size_t i)
+        {
+            updatedMatches_[i]->Update(dt);
+        });
+    for (auto& [matchId, hostedMatch] : matches_)
+    {
+        SendMatchPackets(hostedMatch);
+        hostedMatch.spectatorRelay->TakeFrames(hostedMatch.match->GetSpectatorFrames());
+        hostedMatch.spectatorRelay->Update(dt);
+    }
+    UpdateChannels(dt);
+    datagramBatch_.Flush();
+
+    for (const auto matchId : closedMatches_)
+    {
+        CloseMatch(matchId);
+    }
+    closedMatches_.clear();
+}
+
+void MatchServer::End()
+{
+    while (!matches_.empty())
+    {
+        CloseMatch(matches_.begin()->first);
+    }
+    eventLoop_.Remove(udpSocket_);
+    datagramBatch_.Flush();
+    udpSocket_.unbind();
+    isOpen_ = false;
+}
+
+void MatchServer::SetPort(unsigned short port)
+{
+    udpPort_ = port;
+}
+
+void MatchServer::SetInputBroadcastPeriod(float period)
+{
+    inputBroadcastPeriod_ = period;
+}
+
+void MatchServer::SetPlayerNmb(PlayerNumber playerNmb)
+{
+    gpr_assert(playerNmb > 0 && playerNmb <= MAX_PLAYER_NMB, "Invalid player number of the matches");
+    playerNmb_ = playerNmb;
+}
+
+void MatchServer::SetReplayFolder(std::string_view folder)
+{
+    replayFolder_ = folder;
+}
+
+void MatchServer::ReceiveUdpPackets()
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    while (const auto datagramNmb = datagramBatch_.Receive())
+    {
+        for (std::size_t i = 0; i < datagramNmb; i++)
+        {
+            const auto& datagram = datagramBatch_.GetReceivedDatagram(i);
+            RouteDatagram(datagram);
+        }
+    }
+}
+
+void MatchServer::RouteDatagram(const ReceivedDatagram& datagram)
+{
+    const auto endpointKey = GetEndpointKey(datagram.address, datagram.port);
+    const auto spectatorIt = spectatorEndpoints_.find(endpointKey);
+    if (spectatorIt != spectatorEndpoints_.end())
+    {
+        const auto matchIt = matches_.find(spectatorIt->second);
+        if (matchIt != matches_.end() && matchIt->second.spectatorRelay->ReceiveDatagram(datagram))
+        {
+            return;
+        }
+        //The spectator timed out, or its match is closed
+        spectatorEndpoints_.erase(spectatorIt);
+    }
+    const auto endpointIt = udpEndpoints_.find(endpointKey);
+    if (endpointIt == udpEndpoints_.end())
+    {
+        ReceiveConnectionDatagram(datagram);
+        return;
+    }
+    auto& client = clients_[endpointIt->second];
+    auto& match = *matches_[client.matchId].match;
+    client.channel.ReceiveDatagram(datagram.data, datagram.size, [&match](sf::Packet& packet)
+    {
+        const auto receivedPacket = GenerateReceivedPacket(packet);
+        if (receivedPacket)
+        {
+            match.PushReceivedPacket(*receivedPacket);
+        }
+    });
+}
+
+void MatchServer::ReceiveConnectionDatagram(const ReceivedDatagram& datagram)
+{
+    //Only the first reliable datagram of a client, its join or spectate packet, opens a connection
+    if (!ReliableChannel::IsConnectionDatagram(datagram.data, datagram.size))
+    {
+        return;
+    }
+    ReliableChannel channel;
+    std::optional<PacketVariant> firstPacket;
+    channel.ReceiveDatagram(datagram.data, datagram.size, [&firstPacket](sf::Packet& packet)
+    {
+        firstPacket = GenerateReceivedPacket(packet);
+    });
+    if (!firstPacket)
+    {
+        return;
+    }
+    if (const auto* joinPacket = std::get_if<JoinPacket>(&*firstPacket))
+    {
+        JoinMatch(datagram, channel, *joinPacket);
+    }
+    else if (const auto* spectatePacket = std::get_if<SpectatePacket>(&*firstPacket))
+    {
+        SpectateMatch(datagram, channel, *spectatePacket);
+    }
+}
+
+void MatchServer::JoinMatch(const ReceivedDatagram& datagram, ReliableChannel& channel, const JoinPacket& joinPacket)
+{
+    const auto clientId = core::ConvertFromBinary<ClientId>(joinPacket.clientId);
+    if (clientId == INVALID_CLIENT_ID || clients_.contains(clientId))
+    {
+        core::LogWarning(fmt::format("[MatchServer] Client id {} is already used, refusing the connection",
+            static_cast<unsigned>(clientId)));
+        return;
+    }
+    core::LogDebug(fmt::format("[MatchServer] New connection with address: {} and port: {}",
+        datagram.address.toString(), datagram.port));
+
+    if (fillingMatchId_ == INVALID_MATCH_ID)
+    {
+        fillingMatchId_ = nextMatchId_++;
+        auto& hostedMatch = matches_[fillingMatchId_];
+        hostedMatch.match = std::make_unique<Match>(udpPort_);
+        hostedMatch.spectatorRelay = std::make_unique<SpectatorRelay>(datagramBatch_);
+        hostedMatch.match->SetInputBroadcastPeriod(inputBroadcastPeriod_);
+        hostedMatch.match->SetPlayerNmb(playerNmb_);
+        if (!replayFolder_.empty())
+        {
+            hostedMatch.match->SetReplayPath(fmt::format("{}/match_{}.replay", replayFolder_, fillingMatchId_));
+        }
+        hostedMatch.match->Begin();
+        core::LogDebug(fmt::format("[MatchServer] Opening match {}, {} matches running",
+            fillingMatchId_, matches_.size()));
+    }
+    const auto matchId = fillingMatchId_;
+    auto& hostedMatch = matches_[matchId];
+    hostedMatch.clients[hostedMatch.clientNmb] = clientId;
+    hostedMatch.clientNmb++;
+    if (hostedMatch.clientNmb == hostedMatch.match->GetPlayerNmb())
+    {
+        fillingMatchId_ = INVALID_MATCH_ID;
+    }
+
+    udpEndpoints_[GetEndpointKey(datagram.address, datagram.port)] = clientId;
+    MatchClient client;
+    //The channel already received the join packet and acknowledges it with its next Update
+    client.channel = std::move(channel);
+    client.clientInfo.clientId = clientId;
+    client.clientInfo.udpRemoteAddress = datagram.address;
+    client.clientInfo.udpRemotePort = datagram.port;
+    const auto clientTime = core::ConvertFromBinary<unsigned long>(joinPacket.startTime);
+    using namespace std::chrono;
+    client.clientInfo.timeDifference = static_cast<unsigned long>(
+        duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count()) - clientTime;
+    client.matchId = matchId;
+    clients_.emplace(clientId, std::move(client));
+
+    core::LogDebug(fmt::format("[MatchServer] Client {} joins match {}", static_cast<unsigned>(clientId), matchId));
+    hostedMatch.match->PushReceivedPacket(joinPacket);
+}
+
+void MatchServer::SpectateMatch(const ReceivedDatagram& datagram, ReliableChannel& channel,
+    const SpectatePacket& spectatePacket)
+{
+    auto matchId = core::ConvertFromBinary<MatchId>(spectatePacket.matchId);
+    if (matchId == INVALID_MATCH_ID && !matches_.empty())
+    {
+        //The last opened match
+        matchId = std::max_element(matches_.begin(), matches_.end(), [](const auto& match1, const auto& match2)
+        {
+            return match1.first < match2.first;
+        })->first;
+    }
+    const auto matchIt = matches_.find(matchId);
+    if (matchIt == matches_.end())
+    {
+        core::LogWarning(fmt::format("[MatchServer] Refusing the spectator with address: {} and port: {}, no match {}",
+            datagram.address.toString(), datagram.port, matchId));
+        return;
+    }
+    if (matchIt->second.spectatorRelay->AddSpectator(datagram.address, datagram.port, channel))
+    {
+        spectatorEndpoints_[GetEndpointKey(datagram.address, datagram.port)] = matchId;
+        core::LogDebug(fmt::format("[MatchServer] Spectator with address: {} and port: {} watches match {}",
+            datagram.address.toString(), datagram.port, matchId));
+    }
+}
+
+void MatchServer::SendMatchPackets(HostedMatch& hostedMatch)
+{
+    for (auto& sentPacket : hostedMatch.match->GetSentPackets())
+    {
+        if (!sentPacket.reliable)
+        {
+            const auto payloadId = datagramBatch_.AddPayload(sentPacket.packet);
+            for (std::uint32_t i = 0; i < hostedMatch.clientNmb; i++)
+            {
+                const auto& clientInfo = clients_[hostedMatch.clients[i]].clientInfo;
+                datagramBatch_.QueueSend(payloadId, clientInfo.udpRemoteAddress, clientInfo.udpRemotePort);
+            }
+            continue;
+        }
+        for (std::uint32_t i = 0; i < hostedMatch.clientNmb; i++)
+        {
+            clients_[hostedMatch.clients[i]].channel.Send(sentPacket.packet);
+        }
+    }
+    hostedMatch.match->ClearSentPackets();
+}
+
+void MatchServer::UpdateChannels(sf::Time dt)
+{
+    for (auto& [clientId, client] : clients_)
+    {
+        SendChannelDatagrams(client, dt);
+        if (client.channel.IsTimedOut() &&
+            std::find(closedMatches_.begin(), closedMatches_.end(), client.matchId) == closedMatches_.end())
+        {
+            core::LogDebug(fmt::format("[MatchServer] Client {} timed out, closing match {}",
+                static_cast<unsigned>(clientId), client.matchId));
+            closedMatches_.push_back(client.matchId);
+        }
+    }
+    //A finished match is closed once all its clients acknowledged the WinGamePacket
+    for (const auto& [matchId, hostedMatch] : matches_)
+    {
+        if (hostedMatch.match->GetWinner() == INVALID_PLAYER ||
+            std::find(closedMatches_.begin(), closedMatches_.end(), matchId) != closedMatches_.end())
+        {
+            continue;
+        }
+        const auto clientsBegin = hostedMatch.clients.begin();
+        const bool isAcknowledged = std::all_of(clientsBegin, clientsBegin + hostedMatch.clientNmb,
+            [this](ClientId clientId) { return clients_.at(clientId).channel.IsAcknowledged(); });
+        if (isAcknowledged)
+        {
+            core::LogDebug(fmt::format("[MatchServer] Match {} is over, closing it", matchId));
+            closedMatches_.push_back(matchId);
+        }
+    }
+}
+
+void MatchServer::SendChannelDatagrams(MatchClient& client, sf::Time dt)
+{
+    client.channel.Update(dt, [this, &client](const char* data, std::size_t size)
+    {
+        datagramBatch_.QueueSend(datagramBatch_.AddPayload(data, size),
+            client.clientInfo.udpRemoteAddress, client.clientInfo.udpRemotePort);
+    });
+}
+
+void MatchServer::CloseMatch(MatchId matchId)
+{
+    const auto matchIt = matches_.find(matchId);
+    if (matchIt == matches_.end())
+    {
+        return;
+    }
+    auto& hostedMatch = matchIt->second;
+    //The remaining players win by forfeit, like in NetworkServer, unless the match already has a winner
+    if (hostedMatch.match->GetWinner() == INVALID_PLAYER)
+    {
+        hostedMatch.match->SendReliablePacket(WinGamePacket{});
+    }
+    SendMatchPackets(hostedMatch);
+    hostedMatch.match->End();
+    hostedMatch.spectatorRelay->Close();
+    std::erase_if(spectatorEndpoints_, [matchId](const auto& spectatorEndpoint)
+    {
+        return spectatorEndpoint.second == matchId;
+    });
+
+    for (std::uint32_t i = 0; i < hostedMatch.clientNmb; i++)
+    {
+        const auto clientIt = clients_.find(hostedMatch.clients[i]);
+        //Last send of the win packet, nobody resends it once the client is removed
+        SendChannelDatagrams(clientIt->second, sf::Time());
+        const auto& clientInfo = clientIt->second.clientInfo;
+        udpEndpoints_.erase(GetEndpointKey(clientInfo.udpRemoteAddress, clientInfo.udpRemotePort));
+        clients_.erase(clientIt);
+    }
+    datagramBatch_.Flush();
+    if (fillingMatchId_ == matchId)
+    {
+        fillingMatchId_ = INVALID_MATCH_ID;
+    }
+    matches_.erase(matchIt);
+    core::LogDebug(fmt::format("[MatchServer] Match {} closed, {} matches running", matchId, matches_.size()));
+}
+}
@@ -24,7 +24,6 @@ void NetworkClient::Begin()
                                   std::numeric_limits<std::underlying_type_t<ClientId>>::max()) };
     //JOIN packet
     gameManager_.Begin();
-    tcpSocket_.setBlocking(false);
     udpSocket_.setBlocking(true);
     auto status = sf::Socket::Error;
     while (status != sf::Socket::Done)
@@ -45,40 +44,21 @@ void NetworkClient::Update(sf::Time dt)
     Client::Update(dt);
     if (currentState_ != State::NONE)
     {
+        //Receive UDP datagrams
         auto status = sf::Socket::Done;
-        //Receive TCP Packet
         while (status == sf::Socket::Done)
         {
-            sf::Packet packet;
-            status = tcpSocket_.receive(packet);
-            switch (status)
-            {
-            case sf::Socket::Done:
-                ReceiveNetPacket(packet, PacketSource::TCP);
-                break;
-            case sf::Socket::NotReady:
-                //core::LogDebug("[Client] Error while receiving tcp socket is not ready");
-                break;
-            case sf::Socket::Partial:
-                core::LogDebug("[Client] Error while receiving TCP packet, PARTIAL");
-                break;
-            case sf::Socket::Disconnected: break;
-            case sf::Socket::Error: break;
-            default: break;
-            }
-        }
-        //Receive UDP packet
-        status = sf::Socket::Done;
-        while (status == sf::Socket::Done)
-        {
-            sf::Packet packet;
             sf::IpAddress sender;
             unsigned short port;
-            status = udpSocket_.receive(packet, sender, port);
+            std::size_t received = 0;
+            status = udpSocket_.receive(receiveBuffer_.data(), receiveBuffer_.size(), received, sender, port);
             switch (status)
             {
             case sf::Socket::Done:
-                ReceiveNetPacket(packet, PacketSource::UDP);
+                channel_.ReceiveDatagram(receiveBuffer_.data(), received, [this](sf::Packet& packet)
+                {
+                    ReceiveNetPacket(packet);
+                });
                 break;
             case sf::Socket::NotReady: break;
             case sf::Socket::Partial:
@@ -93,22 +73,11 @@ void NetworkClient::Update(sf::Time dt)
             default:;
             }
         }
-        switch (currentState_)
+        //Acknowledges the received reliable packets and sends the new or lost ones
+        channel_.Update(dt, [this](const char* data, std::size_t size)
         {
-        case State::JOINING:
-        {
-            if (serverUdpPort_ != 0)
-            {
-                //Need to send a join packet on the unreliable channel
-                auto joinPacket = std::make_unique<JoinPacket>();
-                joinPacket->clientId = core::ConvertToBinary<ClientId>(clientId_);
-                SendUnreliablePacket(std::move(joinPacket));
-            }
-            break;
-        }
-        default:
-            break;
-        }
+            SendDatagram(data, size);
+        });
     }
 
     gameManager_.Update(dt);
@@ -139,35 +108,24 @@ void NetworkClient::DrawImGui()
 
     ImGui::InputText("Host", &serverAddress_);
 
-    int portBuffer = serverTcpPort_;
+    int portBuffer = serverPort_;
     if (ImGui::InputInt("Port", &portBuffer))
     {
-        serverTcpPort_ = static_cast<unsigned short>(portBuffer);
+        serverPort_ = static_cast<unsigned short>(portBuffer);
     }
     if (currentState_ == State::NONE &&
         ImGui::Button("Join"))
     {
-        tcpSocket_.setBlocking(true);
-        const auto status = tcpSocket_.connect(serverAddress_, serverTcpPort_);
-        tcpSocket_.setBlocking(false);
-        if (status == sf::Socket::Done)
-        {
-            core::LogDebug("[Client] Connect to server " + serverAddress_ + " with port: " + std::to_string(serverTcpPort_));
-            auto joinPacket = std::make_unique<JoinPacket>();
-            joinPacket->clientId = core::ConvertToBinary<ClientId>(clientId_);
-            using namespace std::chrono;
-            const unsigned long clientTime = static_cast<unsigned long>((duration_cast<milliseconds>(system_clock::now().time_since_epoch())).count());
-            joinPacket->startTime = core::ConvertToBinary<unsigned long>(clientTime);
-            SendReliablePacket(std::move(joinPacket));
-            currentState_ = State::JOINING;
-        }
-        else
-        {
-            core::LogError("[Client] Error trying to connect to " + serverAddress_ + " with port: " +
-                std::to_string(serverTcpPort_) + " with status: " + std::to_string(status));
-        }
+        core::LogDebug("[Client] Join server " + serverAddress_ + " with port: " + std::to_string(serverPort_));
+        //The first reliable packet opens the connection on the server
+        JoinPacket joinPacket;
+        joinPacket.clientId = core::ConvertToBinary<ClientId>(clientId_);
+        using namespace std::chrono;
+        const unsigned long clientTime = static_cast<unsigned long>((duration_cast<milliseconds>(system_clock::now().time_since_epoch())).count());
+        joinPacket.startTime = core::ConvertToBinary<unsigned long>(clientTime);
+        SendReliablePacket(joinPacket);
+        currentState_ = State::JOINING;
     }
-    ImGui::Text("Server UDP port: %u", serverUdpPort_);
     gameManager_.DrawImGui();
     ImGui::End();
 }
@@ -180,34 +138,34 @@ void NetworkClient::Draw(sf::RenderTarget& renderTarget)
     gameManager_.Draw(renderTarget);
 }
 
-void NetworkClient::SendReliablePacket(std::unique_ptr<Packet> packet)
+void NetworkClient::SendReliablePacket(const Packet& packet)
 {
 
     //core::LogDebug("[Client] Sending reliable packet to server");
-    sf::Packet tcpPacket;
-    GeneratePacket(tcpPacket, *packet);
-    auto status = sf::Socket::Partial;
-    while (status == sf::Socket::Partial)
-    {
-        status = tcpSocket_.send(tcpPacket);
-    }
+    //Sent with the next Update of the channel
+    channel_.Send(packet);
 }
 
-void NetworkClient::SendUnreliablePacket(std::unique_ptr<Packet> packet)
+void NetworkClient::SendUnreliablePacket(const Packet& packet)
 {
 
     if (currentState_ == State::NONE)
     {
         return;
     }
-    sf::Packet udpPacket;
-    GeneratePacket(udpPacket, *packet);
-    const auto status = udpSocket_.send(udpPacket, serverAddress_, serverUdpPort_);
+    sendingPacket_.clear();
+    GenerateUnreliableDatagram(sendingPacket_, packet);
+    SendDatagram(static_cast<const char*>(sendingPacket_.getData()), sendingPacket_.getDataSize());
+}
+
+void NetworkClient::SendDatagram(const char* data, std::size_t size)
+{
+    const auto status = udpSocket_.send(data, size, serverAddress_, serverPort_);
     switch (status)
     {
     case sf::Socket::Done:
         //core::LogDebug("[Client] Sending UDP packet to server at host: " +
-        //	serverAddress_.toString() + " port: " + std::to_string(serverUdpPort_));
+        //	serverAddress_.toString() + " port: " + std::to_string(serverPort_));
         break;
     case sf::Socket::NotReady:
         core::LogDebug("[Client] Error sending UDP to server, NOT READY");
@@ -249,22 +207,24 @@ void NetworkClient::ReceivePacket(const Packet* packet)
         debugDb_.StorePacket(inputPacket);
         break;
     }
+    case PacketType::MULTI_INPUT:
+    {
+        auto* multiInputPacket = static_cast<const MultiInputPacket*>(packet);
+        for (std::uint8_t i = 0; i < multiInputPacket->playerInputNmb; i++)
+        {
+            debugDb_.StorePacket(&multiInputPacket->playerInputs[i]);
+        }
+        break;
+    }
     case PacketType::VALIDATE_STATE:
     {
-        auto* validateStatePacket = static_cast<const  *>(packet);
+        auto* validateStatePacket = static_cast<const ValidateFramePacket*>(packet);
         const auto newValidateFrame = core::ConvertFromBinary<Frame>(validateStatePacket->newValidateFrame);
         DbPhysicsState state{};
         state.validateFrame = newValidateFrame;
         state.lastLocalValidateFrame = gameManager_.GetLastValidateFrame();
-        for (size_t i = 0; i < validateStatePacket->physicsState.size(); i++)
-        {
-            auto* statePtr = reinterpret_cast<std::uint8_t*>(state.serverStates.data());
-            statePtr[i] = validateStatePacket->physicsState[i];
-        }
-        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
-        {
-            state.localStates[playerNumber] = gameManager_.GetRollbackManager().GetValidatePhysicsState(playerNumber);
-        }
+        state.serverState = core::ConvertFromBinary<PhysicsState>(validateStatePacket->physicsState);
+        state.localState = gameManager_.GetRollbackManager().GetValidatePhysicsState();
         debugDb_.StorePhysicsState(state);
         break;
     }
@@ -278,34 +238,26 @@ void NetworkClient::ReceivePacket(const Packet* packet)
 #endif
 }
 
-void NetworkClient::ReceiveNetPacket(sf::Packet& packet, PacketSource source)
+void NetworkClient::ReceiveNetPacket(sf::Packet& packet)
 {
     const auto receivePacket = GenerateReceivedPacket(packet);
-    Client::ReceivePacket(receivePacket.get());
-    switch (receivePacket->packetType)
+    if (!receivePacket)
+    {
+        return;
+    }
+    Client::ReceivePacket(&GetPacket(*receivePacket));
+    switch (GetPacket(*receivePacket).packetType)
     {
     case PacketType::JOIN_ACK:
     {
-        core::LogDebug("[Client] Receive " + std::string(source == PacketSource::UDP ? "UDP" : "TCP") + " Join ACK Packet");
-        auto* joinAckPacket = static_cast<JoinAckPacket*>(receivePacket.get());
-
-        serverUdpPort_ = core::ConvertFromBinary<unsigned short>(joinAckPacket->udpPort);
+        core::LogDebug("[Client] Receive Join ACK Packet");
+        const auto* joinAckPacket = std::get_if<JoinAckPacket>(&*receivePacket);
         const auto clientId = core::ConvertFromBinary<ClientId>(joinAckPacket->clientId);
         if (clientId != clientId_)
             return;
-        if (source == PacketSource::TCP)
-        {
-            //Need to send a join packet on the unreliable channel
-            auto joinPacket = std::make_unique<JoinPacket>();
-            joinPacket->clientId = core::ConvertToBinary<ClientId>(clientId_);
-            SendUnreliablePacket(std::move(joinPacket));
-        }
-        else
+        if (currentState_ == State::JOINING)
         {
-            if (currentState_ == State::JOINING)
-            {
-                currentState_ = State::JOINED;
-            }
+            currentState_ = State::JOINED;
         }
         break;
     }
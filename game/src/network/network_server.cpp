@@ -12,41 +12,23 @@
 
 namespace game
 {
-void NetworkServer::SendReliablePacket(
-    std::unique_ptr<Packet> packet)
+void NetworkServer::SendReliablePacket(const Packet& packet)
 {
-    core::LogDebug(fmt::format("[Server] Sending TCP packet: {}",
-        std::to_string(static_cast<int>(packet->packetType))));
-    for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB;
-        playerNumber++)
+    core::LogDebug(fmt::format("[Server] Sending reliable packet: {}",
+        std::to_string(static_cast<int>(packet.packetType))));
+    for (std::uint32_t i = 0; i < connectionNmb_; i++)
     {
-        sf::Packet sendingPacket;
-        GeneratePacket(sendingPacket, *packet);
-
-        auto status = sf::Socket::Partial;
-        while (status == sf::Socket::Partial)
-        {
-            status = tcpSockets_[playerNumber].send(sendingPacket);
-            switch (status)
-            {
-            case sf::Socket::NotReady:
-                core::LogDebug(fmt::format(
-                    "[Server] Error trying to send packet to Player: {} socket is not ready",
-                    playerNumber));
-                break;
-            case sf::Socket::Disconnected:
-                break;
-            default:
-                break;
-            }
-        }
+        connections_[i].channel.Send(packet);
     }
 }
 
-void NetworkServer::SendUnreliablePacket(
-    std::unique_ptr<Packet> packet)
+void NetworkServer::SendUnreliablePacket(const Packet& packet)
 {
-    for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB;
+    //Serialized once for all the players, sent with the other datagrams at the end of Update
+    sendingPacket_.clear();
+    GenerateUnreliableDatagram(sendingPacket_, packet);
+    const auto payloadId = datagramBatch_.AddPayload(sendingPacket_);
+    for (PlayerNumber playerNumber = 0; playerNumber < GetPlayerNmb();
         playerNumber++)
     {
         if (clientInfoMap_[playerNumber].udpRemotePort == 0)
@@ -54,37 +36,9 @@ void NetworkServer::SendUnreliablePacket(
             //core::LogDebug(fmt::format("[Warning] Trying to send UDP packet, but missing port!"));
             continue;
         }
-
-        sf::Packet sendingPacket;
-        GeneratePacket(sendingPacket, *packet);
-        const auto status = udpSocket_.send(sendingPacket, clientInfoMap_[playerNumber].udpRemoteAddress,
+        datagramBatch_.QueueSend(payloadId, clientInfoMap_[playerNumber].udpRemoteAddress,
             clientInfoMap_[playerNumber].udpRemotePort);
-        switch (status)
-        {
-        case sf::Socket::Done:
-            //core::LogDebug("[Server] Sending UDP packet: " +
-                //std::to_string(static_cast<int>(packet->packetType)));
-            break;
-
-        case sf::Socket::Disconnected:
-        {
-            core::LogDebug("[Server] Error while sending UDP packet, DISCONNECTED");
-            break;
-        }
-        case sf::Socket::NotReady:
-            core::LogDebug("[Server] Error while sending UDP packet, NOT READY");
-
-            break;
-
-        case sf::Socket::Error:
-            core::LogDebug("[Server] Error while sending UDP packet, DISCONNECTED");
-            break;
-        default:
-            break;
-        }
-
     }
-
 }
 
 void NetworkServer::Begin()
@@ -94,23 +48,6 @@ void NetworkServer::Begin()
 #endif
     sf::Socket::Status status = sf::Socket::Error;
     while (status != sf::Socket::Done)
-    {
-        // bind the listener to a port
-        status = tcpListener_.listen(tcpPort_);
-        if (status != sf::Socket::Done)
-        {
-            tcpPort_++;
-        }
-    }
-    tcpListener_.setBlocking(false);
-    for (auto& socket : tcpSockets_)
-    {
-        socket.setBlocking(false);
-    }
-    core::LogDebug(fmt::format("[Server] Tcp Socket on port: {}", tcpPort_));
-
-    status = sf::Socket::Error;
-    while (status != sf::Socket::Done)
     {
         status = udpSocket_.bind(udpPort_);
         if (status != sf::Socket::Done)
@@ -121,73 +58,48 @@ void NetworkServer::Begin()
     udpSocket_.setBlocking(false);
     core::LogDebug(fmt::format("[Server] Udp Socket on port: {}", udpPort_));
 
+    eventLoop_.Add(udpSocket_);
+    //The fixed tick wakes the loop up at the game rate, so Update keeps being called without traffic
+    eventLoop_.GetTimerWheel().Schedule(sf::seconds(FIXED_PERIOD), [] {}, sf::seconds(FIXED_PERIOD));
+
     status_ = status_ | OPEN;
+    isSpectated_ = true;
 
 }
 
-void NetworkServer::Update([[maybe_unused]] sf::Time dt)
+void NetworkServer::Update(sf::Time dt)
 {
 
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    if (lastSocketIndex_ < MAX_PLAYER_NMB)
+    for (auto* socket : eventLoop_.Wait())
     {
-        const sf::Socket::Status status = tcpListener_.accept(
-            tcpSockets_[lastSocketIndex_]);
-        if (status == sf::Socket::Done)
+        if (socket == &udpSocket_)
         {
-            const auto remoteAddress = tcpSockets_[lastSocketIndex_].
-                getRemoteAddress();
-            core::LogDebug(fmt::format("[Server] New player connection with address: {} and port: {}",
-                remoteAddress.toString(), tcpSockets_[lastSocketIndex_].getRemotePort()));
-            status_ = status_ | (FIRST_PLAYER_CONNECT << lastSocketIndex_);
-            lastSocketIndex_++;
+            ReceiveUdpPackets();
         }
-    }
-
-    for (PlayerNumber playerNumber = 0; playerNumber < MAX_PLAYER_NMB;
-        playerNumber++)
-    {
-        sf::Packet tcpPacket;
-        switch (tcpSockets_[playerNumber].receive(
-            tcpPacket))
+        if (!IsOpen())
         {
-        case sf::Socket::Done:
-            ReceiveNetPacket(tcpPacket, PacketSocketSource::TCP);
             break;
-        case sf::Socket::Disconnected:
-        {
-            core::LogDebug(fmt::format(
-                "[Error] Player Number {} is disconnected when receiving",
-                playerNumber + 1));
-            status_ = status_ & ~(FIRST_PLAYER_CONNECT << playerNumber);
-            auto endGame = std::make_unique<WinGamePacket>();
-            SendReliablePacket(std::move(endGame));
-            status_ = status_ & ~OPEN; //Close the server
-            break;
-        }
-        default: break;
         }
     }
-    sf::Packet udpPacket;
-    sf::IpAddress address;
-    unsigned short port;
-    const auto status = udpSocket_.receive(udpPacket, address, port);
-    if (status == sf::Socket::Done)
-    {
-        ReceiveNetPacket(udpPacket, PacketSocketSource::UDP, address, port);
-    }
+    UpdateInputBroadcast(dt.asSeconds());
+    UpdateConnections(dt);
+    spectatorRelay_.TakeFrames(spectatorFrames_);
+    spectatorRelay_.Update(dt);
+    datagramBatch_.Flush();
 }
 
 void NetworkServer::End()
 {
-
+    spectatorRelay_.Close();
+    datagramBatch_.Flush();
 }
 
-void NetworkServer::SetTcpPort(unsigned short i)
+void NetworkServer::SetPort(unsigned short port)
 {
-    tcpPort_ = i;
+    udpPort_ = port;
 }
 
 bool NetworkServer::IsOpen() const
@@ -201,90 +113,150 @@ void NetworkServer::SpawnNewPlayer([[maybe_unused]] ClientId clientId, [[maybe_u
     //Spawning the new player in the arena
     for (PlayerNumber p = 0; p <= lastPlayerNumber_; p++)
     {
-        auto spawnPlayer = std::make_unique<SpawnPlayerPacket>();
-        spawnPlayer->clientId = core::ConvertToBinary(clientMap_[p]);
-        spawnPlayer->playerNumber = p;
+        SpawnPlayerPacket spawnPlayer;
+        spawnPlayer.clientId = core::ConvertToBinary(clientMap_[p]);
+        spawnPlayer.playerNumber = p;
 
         const auto pos = SPAWN_POSITIONS[p] * 3.0f;
-        spawnPlayer->pos = ConvertToBinary(pos);
+        spawnPlayer.pos = ConvertToBinary(pos);
 
         const auto rotation = SPAWN_ROTATIONS[p];
-        spawnPlayer->angle = core::ConvertToBinary(rotation);
+        spawnPlayer.angle = core::ConvertToBinary(rotation);
         gameManager_.SpawnPlayer(p, pos, rotation);
         gameManager_.SpawnGloves(p, pos, rotation);
 
-        SendReliablePacket(std::move(spawnPlayer));
+        SendReliablePacket(spawnPlayer);
     }
 }
 
 
-void NetworkServer::ProcessReceivePacket(
-    std::unique_ptr<Packet> packet,
-    PacketSocketSource packetSource,
-    sf::IpAddress address,
-    unsigned short port)
+void NetworkServer::ProcessReceivePacket(const Packet& packet, const Connection& connection)
 {
 
-    const auto packetType = static_cast<PacketType>(packet->packetType);
+    const auto packetType = packet.packetType;
     switch (packetType)
     {
     case PacketType::JOIN:
     {
-        const auto joinPacket = *static_cast<JoinPacket*>(packet.get());
-        Server::ReceivePacket(std::move(packet));
+        const auto& joinPacket = static_cast<const JoinPacket&>(packet);
+        Server::ReceivePacket(packet);
         auto clientId = core::ConvertFromBinary<ClientId>(joinPacket.clientId);
-        core::LogDebug(fmt::format("[Server] Received Join Packet from: {} {}", static_cast<unsigned>(clientId),
-            (packetSource == PacketSocketSource::UDP ? fmt::format(" UDP with port: {}", port) : " TCP")));
+        core::LogDebug(fmt::format("[Server] Received Join Packet from: {} with address: {} and port: {}",
+            static_cast<unsigned>(clientId), connection.address.toString(), connection.port));
         const auto it = std::find(clientMap_.begin(), clientMap_.end(), clientId);
-        PlayerNumber playerNumber;
-        if (it != clientMap_.end())
+        //Server::ReceivePacket refuses the joins when the game is full, the client has no player number then
+        if (it == clientMap_.end())
         {
-            playerNumber = static_cast<PlayerNumber>(std::distance(clientMap_.begin(), it));
-            clientInfoMap_[playerNumber].clientId = clientId;
+            core::LogDebug(fmt::format("[Server] Refused the join of {}, no player number",
+                static_cast<unsigned>(clientId)));
+            return;
         }
-        else
+        const auto playerNumber = static_cast<PlayerNumber>(std::distance(clientMap_.begin(), it));
+        clientInfoMap_[playerNumber].clientId = clientId;
+
+        auto& clientInfo = clientInfoMap_[playerNumber];
+        clientInfo.udpRemoteAddress = connection.address;
+        clientInfo.udpRemotePort = connection.port;
+        status_ = status_ | (FIRST_PLAYER_CONNECT << playerNumber);
+
+        JoinAckPacket joinAckPacket;
+        joinAckPacket.clientId = core::ConvertToBinary(clientId);
+        joinAckPacket.udpPort = core::ConvertToBinary(udpPort_);
+        SendReliablePacket(joinAckPacket);
+        //Calculate time difference
+        const auto clientTime = core::ConvertFromBinary<unsigned long>(joinPacket.startTime);
+        using namespace std::chrono;
+        const unsigned long deltaTime = static_cast<unsigned long>((duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count())) - clientTime;
+        core::LogDebug(fmt::format("[Server] Client Server deltaTime: {}", deltaTime));
+        clientInfo.timeDifference = deltaTime;
+        break;
+    }
+    default:
+        Server::ReceivePacket(packet);
+        break;
+    }
+}
+
+NetworkServer::Connection* NetworkServer::FindConnection(const ReceivedDatagram& datagram)
+{
+    for (std::uint32_t i = 0; i < connectionNmb_; i++)
+    {
+        if (connections_[i].address == datagram.address && connections_[i].port == datagram.port)
         {
-            gpr_assert(false, "Player Number is supposed to be already set before join!");
+            return &connections_[i];
         }
+    }
+    //Only the first reliable datagram of a client opens its connection
+    if (connectionNmb_ == GetPlayerNmb() ||
+        !ReliableChannel::IsConnectionDatagram(datagram.data, datagram.size))
+    {
+        return nullptr;
+    }
+    auto& connection = connections_[connectionNmb_];
+    connection.address = datagram.address;
+    connection.port = datagram.port;
+    connectionNmb_++;
+    core::LogDebug(fmt::format("[Server] New player connection with address: {} and port: {}",
+        datagram.address.toString(), datagram.port));
+    return &connection;
+}
 
-        auto joinAckPacket = std::make_unique<JoinAckPacket>();
-        joinAckPacket->clientId = core::ConvertToBinary(clientId);
-        joinAckPacket->udpPort = core::ConvertToBinary(udpPort_);
-        if (packetSource == PacketSocketSource::UDP)
+void NetworkServer::ReceiveUdpPackets()
+{
+    while (const auto datagramNmb = datagramBatch_.Receive())
+    {
+        for (std::size_t i = 0; i < datagramNmb; i++)
         {
-            auto& clientInfo = clientInfoMap_[playerNumber];
-            clientInfo.udpRemoteAddress = address;
-            clientInfo.udpRemotePort = port;
-            SendUnreliablePacket(std::move(joinAckPacket));
+            const auto& datagram = datagramBatch_.GetReceivedDatagram(i);
+            //Checked first, the connection datagram of a spectator would otherwise open a player connection
+            if (spectatorRelay_.ReceiveDatagram(datagram) || spectatorRelay_.ReceiveConnectionDatagram(datagram))
+            {
+                continue;
+            }
+            auto* connection = FindConnection(datagram);
+            if (connection == nullptr)
+            {
+                continue;
+            }
+            connection->channel.ReceiveDatagram(datagram.data, datagram.size, [this, connection](sf::Packet& packet)
+            {
+                ReceiveNetPacket(packet, *connection);
+            });
         }
-        else
+    }
+}
+
+void NetworkServer::UpdateConnections(sf::Time dt)
+{
+    for (std::uint32_t i = 0; i < connectionNmb_ && IsOpen(); i++)
+    {
+        const auto& connection = connections_[i];
+        if (connection.channel.IsTimedOut())
         {
-            SendReliablePacket(std::move(joinAckPacket));
-            //Calculate time difference
-            const auto clientTime = core::ConvertFromBinary<unsigned long>(joinPacket.startTime);
-            using namespace std::chrono;
-            const unsigned long deltaTime = static_cast<unsigned long>((duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count())) - clientTime;
-            core::LogDebug(fmt::format("[Server] Client Server deltaTime: {}", deltaTime));
-            clientInfoMap_[playerNumber].timeDifference = deltaTime;
+            core::LogDebug(fmt::format(
+                "[Error] Player with address: {} and port: {} timed out",
+                connection.address.toString(), connection.port));
+            SendReliablePacket(WinGamePacket{});
+            status_ = status_ & ~OPEN; //Close the server
         }
-        break;
     }
-    default:
-        Server::ReceivePacket(std::move(packet));
-        break;
+    for (std::uint32_t i = 0; i < connectionNmb_; i++)
+    {
+        auto& connection = connections_[i];
+        connection.channel.Update(dt, [this, &connection](const char* data, std::size_t size)
+        {
+            datagramBatch_.QueueSend(datagramBatch_.AddPayload(data, size), connection.address, connection.port);
+        });
     }
 }
 
-void NetworkServer::ReceiveNetPacket(sf::Packet& packet,
-    PacketSocketSource packetSource,
-    sf::IpAddress address,
-    unsigned short port)
+void NetworkServer::ReceiveNetPacket(sf::Packet& packet, const Connection& connection)
 {
-    auto receivedPacket = GenerateReceivedPacket(packet);
+    const auto receivedPacket = GenerateReceivedPacket(packet);
 
-    if (receivedPacket != nullptr)
+    if (receivedPacket.has_value())
     {
-        ProcessReceivePacket(std::move(receivedPacket), packetSource, address, port);
+        ProcessReceivePacket(GetPacket(*receivedPacket), connection);
     }
 }
 }
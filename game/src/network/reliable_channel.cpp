@@ -0,0 +1,65 @@
+#include <network/reliable_channel.h>
+
+namespace game
+{
+void GenerateUnreliableDatagram(sf::Packet& datagram, const Packet& packet)
+{
+    datagram << static_cast<std::uint8_t>(DatagramType::UNRELIABLE);
+    GeneratePacket(datagram, packet);
+}
+
+void ReliableChannel::Send(const Packet& packet)
+{
+    sendingPacket_.clear();
+    GeneratePacket(sendingPacket_, packet);
+    Send(sendingPacket_);
+}
+
+void ReliableChannel::Send(const sf::Packet& packet)
+{
+    SentDatagram sentDatagram;
+    sentDatagram.sequence = nextSendSequence_;
+    const auto* data = static_cast<const char*>(packet.getData());
+    sentDatagram.data.reserve(1 + sizeof(ReliableSequence) + packet.getDataSize());
+    sentDatagram.data.push_back(static_cast<char>(DatagramType::RELIABLE));
+    sentDatagram.data.push_back(static_cast<char>(nextSendSequence_ >> 8u));
+    sentDatagram.data.push_back(static_cast<char>(nextSendSequence_ & 0xFFu));
+    sentDatagram.data.insert(sentDatagram.data.end(), data, data + packet.getDataSize());
+    sentDatagrams_.push_back(std::move(sentDatagram));
+    nextSendSequence_++;
+}
+
+bool ReliableChannel::IsConnectionDatagram(const char* data, std::size_t size)
+{
+    return size > 1 + sizeof(ReliableSequence) &&
+        static_cast<DatagramType>(data[0]) == DatagramType::RELIABLE &&
+        ReadSequence(data + 1) == 0;
+}
+
+void ReliableChannel::Acknowledge(ReliableSequence nextSequence)
+{
+    //Sequences wrap around, the difference tells which one is older
+    while (!sentDatagrams_.empty() &&
+        static_cast<std::int16_t>(static_cast<ReliableSequence>(nextSequence - sentDatagrams_.front().sequence)) > 0)
+    {
+        sentDatagrams_.pop_front();
+    }
+}
+
+void ReliableChannel::BufferReliable(ReliableSequence sequence, const char* data, std::size_t size)
+{
+    const auto distance = static_cast<ReliableSequence>(sequence - nextReceiveSequence_);
+    //Older sequences were already delivered, the too far ones will be sent again
+    if (distance >= RELIABLE_WINDOW || receivedBodies_.contains(sequence))
+    {
+        return;
+    }
+    receivedBodies_.emplace(sequence, std::vector<char>(data, data + size));
+}
+
+ReliableSequence ReliableChannel::ReadSequence(const char* data)
+{
+    return static_cast<ReliableSequence>(
+        (static_cast<unsigned>(static_cast<std::uint8_t>(data[0])) << 8u) | static_cast<std::uint8_t>(data[1]));
+}
+}
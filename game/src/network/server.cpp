@@ -2,6 +2,7 @@
 #include <utils/log.h>
 #include <fmt/format.h>
 #include <utils/conversion.h>
+#include <algorithm>
 #include <cstdint>
 
 #ifdef TRACY_ENABLE
@@ -11,18 +12,18 @@
 namespace game
 {
 
-void Server::ReceivePacket(std::unique_ptr<Packet> packet)
+void Server::ReceivePacket(const Packet& packet)
 {
 
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    switch (packet->packetType)
+    switch (packet.packetType)
     {
     case PacketType::JOIN:
     {
-        const auto* joinPacket = static_cast<const JoinPacket*>(packet.get());
-        const auto clientId = core::ConvertFromBinary<ClientId>(joinPacket->clientId);
+        const auto& joinPacket = static_cast<const JoinPacket&>(packet);
+        const auto clientId = core::ConvertFromBinary<ClientId>(joinPacket.clientId);
         if (std::any_of(clientMap_.begin(), clientMap_.end(), [clientId](const auto clientMapId)
             {
                 return clientMapId == clientId;
@@ -30,6 +31,12 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
         {
             //Player joined twice!
             return;
+        }
+        if (lastPlayerNumber_ == gameManager_.GetPlayerNmb())
+        {
+            core::LogWarning(fmt::format("Refusing the join of {}, the game is full",
+                static_cast<unsigned>(clientId)));
+            return;
         }
             core::LogDebug("Managing Received Packet Join from: " + std::to_string(static_cast<unsigned>(clientId)));
             clientMap_[lastPlayerNumber_] = clientId;
@@ -37,12 +44,20 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
 
             lastPlayerNumber_++;
 
-            if (lastPlayerNumber_ == MAX_PLAYER_NMB)
+            if (lastPlayerNumber_ == gameManager_.GetPlayerNmb())
             {
-                auto startGamePacket = std::make_unique<StartGamePacket>();
-                startGamePacket->packetType = PacketType::START_GAME;
                 core::LogDebug("Send Start Game Packet");
-                SendReliablePacket(std::move(startGamePacket));
+                StartGamePacket startGamePacket;
+                startGamePacket.playerNmb = lastPlayerNumber_;
+                SendReliablePacket(startGamePacket);
+                if (!replayPath_.empty())
+                {
+                    replayWriter_.Open(replayPath_, gameManager_);
+                }
+                if (isSpectated_)
+                {
+                    spectatorFrames_.Start(gameManager_);
+                }
             }
 
             break;
@@ -50,27 +65,52 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
     case PacketType::INPUT:
     {
         //Manage internal state
-        const auto* playerInputPacket = static_cast<const PlayerInputPacket*>(packet.get());
-        const auto playerNumber = playerInputPacket->playerNumber;
-        const auto inputFrame = core::ConvertFromBinary<Frame>(playerInputPacket->currentFrame);
+        const auto& playerInputPacket = static_cast<const PlayerInputPacket&>(packet);
+        const auto playerNumber = playerInputPacket.playerNumber;
+        if (playerNumber >= gameManager_.GetPlayerNmb())
+        {
+            break;
+        }
+        const auto inputFrame = core::ConvertFromBinary<Frame>(playerInputPacket.currentFrame);
 
-        for (std::uint32_t i = 0; i < playerInputPacket->inputs.size(); i++)
+        const auto& rollbackManager = gameManager_.GetRollbackManager();
+        //The frames before the first missing one were all received, the rest of the packet is skipped
+        const auto firstMissingFrame = rollbackManager.GetFirstMissingInputFrame(playerNumber);
+        for (std::uint32_t i = 0; i < playerInputPacket.inputNmb; i++)
         {
-            gameManager_.SetPlayerInput(playerNumber,
-                playerInputPacket->inputs[i],
-                inputFrame - i);
-            if (inputFrame - i == 0)
+            const auto frame = inputFrame - i;
+            if (frame < firstMissingFrame)
+            {
+                break;
+            }
+            //Inputs received in a previous packet are already confirmed
+            if (!rollbackManager.IsInputConfirmed(playerNumber, frame))
+            {
+                gameManager_.SetPlayerInput(playerNumber,
+                    playerInputPacket.inputs[i],
+                    frame);
+            }
+            if (frame == 0)
             {
                 break;
             }
         }
-        
 
-        SendUnreliablePacket(std::move(packet));
+        if (inputBroadcastPeriod_ > 0.0f)
+        {
+            //Sent with the other players inputs by UpdateInputBroadcast
+            pendingInputPlayers_.set(playerNumber);
+        }
+        else
+        {
+            PlayerInputPacket echoPacket;
+            FillInputEcho(playerNumber, echoPacket);
+            SendUnreliablePacket(echoPacket);
+        }
 
         //Validate new frame if needed
         std::uint32_t lastReceiveFrame = gameManager_.GetRollbackManager().GetLastReceivedFrame(0);
-        for (PlayerNumber i = 1; i < MAX_PLAYER_NMB; i++)
+        for (PlayerNumber i = 1; i < gameManager_.GetPlayerNmb(); i++)
         {
             const auto playerLastFrame = gameManager_.GetRollbackManager().GetLastReceivedFrame(i);
             if (playerLastFrame < lastReceiveFrame)
@@ -82,29 +122,28 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
         {
             //Validate frame
             gameManager_.Validate(lastReceiveFrame);
+            replayWriter_.WriteValidatedFrames(gameManager_);
+            spectatorFrames_.AddValidatedFrames(gameManager_);
 
-            auto validatePacket = std::make_unique<ValidateFramePacket>();
-            validatePacket->newValidateFrame = core::ConvertToBinary(lastReceiveFrame);
-
-            //copy physics state
-            for (PlayerNumber i = 0; i < MAX_PLAYER_NMB; i++)
+            ValidateFramePacket validatePacket;
+            validatePacket.newValidateFrame = core::ConvertToBinary(lastReceiveFrame);
+            validatePacket.physicsState = core::ConvertToBinary(gameManager_.GetRollbackManager().GetValidatePhysicsState());
+            validatePacket.inputAckNmb = gameManager_.GetPlayerNmb();
+            for (PlayerNumber i = 0; i < validatePacket.inputAckNmb; i++)
             {
-                auto physicsState = gameManager_.GetRollbackManager().GetValidatePhysicsState(i);
-                const auto* statePtr = reinterpret_cast<const std::uint8_t*>(&physicsState);
-                for (size_t j = 0; j < sizeof(PhysicsState); j++)
-                {
-                    validatePacket->physicsState[i * sizeof(PhysicsState) + j] = statePtr[j];
-                }
+                validatePacket.inputAckFrames[i] = core::ConvertToBinary(rollbackManager.GetFirstMissingInputFrame(i));
             }
-            SendUnreliablePacket(std::move(validatePacket));
+            SendUnreliablePacket(validatePacket);
             const auto winner = gameManager_.CheckWinner();
             if (winner != INVALID_PLAYER)
             {
-                core::LogDebug(fmt::format("Server declares P{} a winner", static_cast<unsigned>(winner) + 1));
-                auto winGamePacket = std::make_unique<WinGamePacket>();
-                winGamePacket->winner = winner;
-                SendReliablePacket(std::move(winGamePacket));
+                core::LogDebug(winner == DRAW_PLAYER ? std::string("Server declares a draw") :
+                    fmt::format("Server declares P{} a winner", static_cast<unsigned>(winner) + 1));
+                WinGamePacket winGamePacket;
+                winGamePacket.winner = winner;
+                SendReliablePacket(winGamePacket);
                 gameManager_.WinGame(winner);
+                replayWriter_.Close();
             }
         }
 
@@ -112,12 +151,60 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
     }
     case PacketType::PING:
     {
-        auto pingPacket = std::make_unique<PingPacket>();
-        *pingPacket = *static_cast<PingPacket*>(packet.get());
-        SendUnreliablePacket(std::move(pingPacket));
+        SendUnreliablePacket(packet);
         break;
     }
     default: break;
     }
 }
+
+void Server::UpdateInputBroadcast(float dt)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    inputBroadcastTimer_ += dt;
+    if (inputBroadcastTimer_ < inputBroadcastPeriod_)
+    {
+        return;
+    }
+    //A late update does not send several packets in a row to catch up
+    inputBroadcastTimer_ = std::min(inputBroadcastTimer_ - inputBroadcastPeriod_, inputBroadcastPeriod_);
+    if (pendingInputPlayers_.none())
+    {
+        return;
+    }
+    MultiInputPacket multiInputPacket;
+    for (PlayerNumber playerNumber = 0; playerNumber < gameManager_.GetPlayerNmb(); playerNumber++)
+    {
+        if (pendingInputPlayers_.test(playerNumber))
+        {
+            FillInputEcho(playerNumber, multiInputPacket.playerInputs[multiInputPacket.playerInputNmb]);
+            multiInputPacket.playerInputNmb++;
+        }
+    }
+    pendingInputPlayers_.reset();
+    SendUnreliablePacket(multiInputPacket);
+}
+
+void Server::FillInputEcho(PlayerNumber playerNumber, PlayerInputPacket& inputPacket) const
+{
+    //The client only sent the inputs the server did not acknowledge, but the other clients may have lost
+    //the previous echoes, so the echo carries the confirmed inputs of the whole window
+    const auto& rollbackManager = gameManager_.GetRollbackManager();
+    inputPacket.playerNumber = playerNumber;
+    const auto lastReceivedFrame = rollbackManager.GetLastReceivedFrame(playerNumber);
+    inputPacket.currentFrame = core::ConvertToBinary(lastReceivedFrame);
+    inputPacket.inputNmb = 0;
+    while (inputPacket.inputNmb < MAX_INPUT_NMB && inputPacket.inputNmb <= lastReceivedFrame)
+    {
+        const auto frame = lastReceivedFrame - inputPacket.inputNmb;
+        if (!rollbackManager.IsInputConfirmed(playerNumber, frame))
+        {
+            break;
+        }
+        inputPacket.inputs[inputPacket.inputNmb] = rollbackManager.GetInputAtFrame(playerNumber, frame);
+        inputPacket.inputNmb++;
+    }
+}
 }
@@ -15,6 +15,8 @@ namespace game
 SimulationClient::SimulationClient(SimulationServer& server) :
     server_(server)
 {
+    clientId_ = ClientId{ core::RandomRange(std::numeric_limits<std::underlying_type_t<ClientId>>::lowest(),
+                                  std::numeric_limits<std::underlying_type_t<ClientId>>::max()) };
 }
 
 void SimulationClient::Begin()
@@ -22,8 +24,6 @@ void SimulationClient::Begin()
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    clientId_ = ClientId{ core::RandomRange(std::numeric_limits<std::underlying_type_t<ClientId>>::lowest(),
-                                  std::numeric_limits<std::underlying_type_t<ClientId>>::max()) };
 #ifdef ENABLE_SQLITE
     debugDb_.Open(fmt::format("Client_{}.db", static_cast<unsigned>(clientId_)));
 #endif
@@ -74,19 +74,24 @@ void SimulationClient::SetPlayerInput(PlayerInput playerInput)
 
 }
 
+void SimulationClient::Join()
+{
+    JoinPacket joinPacket;
+    const auto* clientIdPtr = reinterpret_cast<std::uint8_t*>(&clientId_);
+    for (std::size_t i = 0; i < sizeof(clientId_); i++)
+    {
+        joinPacket.clientId[i] = clientIdPtr[i];
+    }
+    SendReliablePacket(joinPacket);
+}
+
 void SimulationClient::DrawImGui()
 {
     const auto windowName = "Client " + std::to_string(static_cast<unsigned>(clientId_));
     ImGui::Begin(windowName.c_str());
     if (gameManager_.GetPlayerNumber() == INVALID_PLAYER && ImGui::Button("Spawn Player"))
     {
-        auto joinPacket = std::make_unique<JoinPacket>();
-        const auto* clientIdPtr = reinterpret_cast<std::uint8_t*>(&clientId_);
-        for (std::size_t i = 0; i < sizeof(clientId_); i++)
-        {
-            joinPacket->clientId[i] = clientIdPtr[i];
-        }
-        SendReliablePacket(std::move(joinPacket));
+        Join();
     }
     gameManager_.DrawImGui();
     if (srtt_ > 0.0f)
@@ -98,14 +103,14 @@ void SimulationClient::DrawImGui()
     ImGui::End();
 }
 
-void SimulationClient::SendUnreliablePacket(std::unique_ptr<Packet> packet)
+void SimulationClient::SendUnreliablePacket(const Packet& packet)
 {
-    server_.PutPacketInReceiveQueue(std::move(packet),true);
+    server_.PutPacketInReceiveQueue(packet,true);
 }
 
-void SimulationClient::SendReliablePacket(std::unique_ptr<Packet> packet)
+void SimulationClient::SendReliablePacket(const Packet& packet)
 {
-    server_.PutPacketInReceiveQueue(std::move(packet),false);
+    server_.PutPacketInReceiveQueue(packet,false);
 }
 
 void SimulationClient::ReceivePacket(const Packet* packet)
@@ -122,6 +127,15 @@ void SimulationClient::ReceivePacket(const Packet* packet)
         debugDb_.StorePacket(inputPacket);
         break;
     }
+    case PacketType::MULTI_INPUT:
+    {
+        auto* multiInputPacket = static_cast<const MultiInputPacket*>(packet);
+        for (std::uint8_t i = 0; i < multiInputPacket->playerInputNmb; i++)
+        {
+            debugDb_.StorePacket(&multiInputPacket->playerInputs[i]);
+        }
+        break;
+    }
     case PacketType::VALIDATE_STATE:
     {
         auto* validateStatePacket = static_cast<const ValidateFramePacket*>(packet);
@@ -129,15 +143,8 @@ void SimulationClient::ReceivePacket(const Packet* packet)
         DbPhysicsState state{};
         state.validateFrame = newValidateFrame;
         state.lastLocalValidateFrame = gameManager_.GetLastValidateFrame();
-        for (size_t i = 0; i < validateStatePacket->physicsState.size(); i++)
-        {
-            auto* statePtr = reinterpret_cast<std::uint8_t*>(state.serverStates.data());
-            statePtr[i] = validateStatePacket->physicsState[i];
-        }
-        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
-        {
-            state.localStates[playerNumber] = gameManager_.GetRollbackManager().GetValidatePhysicsState(playerNumber);
-        }
+        state.serverState = core::ConvertFromBinary<PhysicsState>(validateStatePacket->physicsState);
+        state.localState = gameManager_.GetRollbackManager().GetValidatePhysicsState();
         debugDb_.StorePhysicsState(state);
         break;
     }
@@ -11,8 +11,9 @@
 
 namespace game
 {
-SimulationServer::SimulationServer(std::array<std::unique_ptr<SimulationClient>, 2>& clients) : clients_(clients)
+SimulationServer::SimulationServer(std::span<std::unique_ptr<SimulationClient>> clients) : clients_(clients)
 {
+    SetPlayerNmb(static_cast<PlayerNumber>(clients_.size()));
 }
 
 void SimulationServer::Begin()
@@ -32,7 +33,7 @@ void SimulationServer::Update(sf::Time dt)
         packetIt->currentTime -= dt.asSeconds();
         if (packetIt->currentTime <= 0.0f)
         {
-            ProcessReceivePacket(std::move(packetIt->packet));
+            ProcessReceivePacket(GetPacket(packetIt->packet));
 
             packetIt = receivedPackets_.erase(packetIt);
         }
@@ -42,6 +43,7 @@ void SimulationServer::Update(sf::Time dt)
         }
 
     }
+    UpdateInputBroadcast(dt.asSeconds());
 
     packetIt = sentPackets_.begin();
     while (packetIt != sentPackets_.end())
@@ -51,9 +53,8 @@ void SimulationServer::Update(sf::Time dt)
         {
             for (auto& client : clients_)
             {
-                client->ReceivePacket(packetIt->packet.get());
+                client->ReceivePacket(&GetPacket(packetIt->packet));
             }
-            packetIt->packet = nullptr;
             packetIt = sentPackets_.erase(packetIt);
         }
         else
@@ -81,15 +82,22 @@ void SimulationServer::DrawImGui()
         marginDelay_ = (maxDelay - minDelay) / 2.0f;
     }
     ImGui::SliderFloat("Packet Loss", &packetLoss_, 0.0f, 1.0f);
+    ImGui::SliderFloat("Input Broadcast Period", &inputBroadcastPeriod_, 0.0f, 0.1f);
     ImGui::End();
 }
 
-void SimulationServer::PutPacketInSendingQueue(std::unique_ptr<Packet> packet)
+void SimulationServer::SetDelay(float avgDelay, float marginDelay)
 {
-    sentPackets_.push_back({ avgDelay_ + core::RandomRange(-marginDelay_, marginDelay_), std::move(packet) });
+    avgDelay_ = avgDelay;
+    marginDelay_ = std::min(marginDelay, avgDelay);
 }
 
-void SimulationServer::PutPacketInReceiveQueue(std::unique_ptr<Packet> packet, bool unreliable)
+void SimulationServer::PutPacketInSendingQueue(const Packet& packet)
+{
+    sentPackets_.push_back({ avgDelay_ + core::RandomRange(-marginDelay_, marginDelay_), ToPacketVariant(packet) });
+}
+
+void SimulationServer::PutPacketInReceiveQueue(const Packet& packet, bool unreliable)
 {
     if(unreliable)
     {
@@ -99,38 +107,37 @@ void SimulationServer::PutPacketInReceiveQueue(std::unique_ptr<Packet> packet, b
             return;
         }
     }
-    receivedPackets_.push_back({ avgDelay_ + core::RandomRange(-marginDelay_, marginDelay_), std::move(packet) });
+    receivedPackets_.push_back({ avgDelay_ + core::RandomRange(-marginDelay_, marginDelay_), ToPacketVariant(packet) });
 }
 
-void SimulationServer::SendReliablePacket(std::unique_ptr<Packet> packet)
+void SimulationServer::SendReliablePacket(const Packet& packet)
 {
-    PutPacketInSendingQueue(std::move(packet));
+    PutPacketInSendingQueue(packet);
 }
 
-void SimulationServer::SendUnreliablePacket(std::unique_ptr<Packet> packet)
+void SimulationServer::SendUnreliablePacket(const Packet& packet)
 {
-    PutPacketInSendingQueue(std::move(packet));
+    PutPacketInSendingQueue(packet);
 }
 
-void SimulationServer::ProcessReceivePacket(std::unique_ptr<Packet> packet)
+void SimulationServer::ProcessReceivePacket(const Packet& packet)
 {
-    Server::ReceivePacket(std::move(packet));
+    Server::ReceivePacket(packet);
 }
 
 void SimulationServer::SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber)
 {
     core::LogDebug("[Server] Spawn new player");
-    auto spawnPlayer = std::make_unique<SpawnPlayerPacket>();
-    spawnPlayer->packetType = PacketType::SPAWN_PLAYER;
-    spawnPlayer->clientId = core::ConvertToBinary(clientId);
-    spawnPlayer->playerNumber = playerNumber;
+    SpawnPlayerPacket spawnPlayer;
+    spawnPlayer.clientId = core::ConvertToBinary(clientId);
+    spawnPlayer.playerNumber = playerNumber;
 
     const auto pos = SPAWN_POSITIONS[playerNumber] * 3.0f;
-    spawnPlayer->pos = ConvertToBinary(pos);
+    spawnPlayer.pos = ConvertToBinary(pos);
     const auto rotation = SPAWN_ROTATIONS[playerNumber];
-    spawnPlayer->angle = core::ConvertToBinary(rotation);
+    spawnPlayer.angle = core::ConvertToBinary(rotation);
     gameManager_.SpawnPlayer(playerNumber, pos, rotation);
     gameManager_.SpawnGloves(playerNumber, pos, rotation);
-    SendReliablePacket(std::move(spawnPlayer));
+    SendReliablePacket(spawnPlayer);
 }
 }
@@ -0,0 +1,205 @@
+#include <network/spectator_client.h>
+#include "network/spectator_relay.h"
+#include "maths/basic.h"
+#include "utils/conversion.h"
+#include "utils/log.h"
+
+#include <fmt/format.h>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+void SpectatorClient::Begin()
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    clientId_ = ClientId{ core::RandomRange<std::underlying_type_t<ClientId>>(1,
+        std::numeric_limits<std::underlying_type_t<ClientId>>::max()) };
+    udpSocket_.setBlocking(true);
+    auto status = sf::Socket::Error;
+    while (status != sf::Socket::Done)
+    {
+        status = udpSocket_.bind(sf::Socket::AnyPort);
+    }
+    udpSocket_.setBlocking(false);
+
+    core::LogDebug(fmt::format("[Spectator] Spectate server {} with port: {}", serverAddress_, serverPort_));
+    //The first reliable packet opens the connection on the server
+    SpectatePacket spectatePacket;
+    spectatePacket.clientId = core::ConvertToBinary(clientId_);
+    spectatePacket.matchId = core::ConvertToBinary(matchId_);
+    channel_.Send(spectatePacket);
+}
+
+void SpectatorClient::Update(sf::Time dt)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    auto status = sf::Socket::Done;
+    while (status == sf::Socket::Done && !isOver_)
+    {
+        sf::IpAddress sender;
+        unsigned short port;
+        std::size_t received = 0;
+        status = udpSocket_.receive(receiveBuffer_.data(), receiveBuffer_.size(), received, sender, port);
+        if (status == sf::Socket::Done)
+        {
+            channel_.ReceiveDatagram(receiveBuffer_.data(), received, [this](sf::Packet& packet)
+            {
+                ReceiveNetPacket(packet);
+            });
+        }
+    }
+
+    //Tells the relay where the spectator is, and keeps the connection alive
+    ackTimer_ += dt.asSeconds();
+    if (ackTimer_ >= SPECTATOR_ACK_PERIOD)
+    {
+        ackTimer_ = 0.0f;
+        SpectatorAckPacket ackPacket;
+        ackPacket.nextFrame = core::ConvertToBinary<Frame>(gameManager_.GetLastValidateFrame() + 1);
+        sendingPacket_.clear();
+        GenerateUnreliableDatagram(sendingPacket_, ackPacket);
+        SendDatagram(static_cast<const char*>(sendingPacket_.getData()), sendingPacket_.getDataSize());
+    }
+    channel_.Update(dt, [this](const char* data, std::size_t size)
+    {
+        SendDatagram(data, size);
+    });
+    if (channel_.IsTimedOut() && !isOver_)
+    {
+        core::LogWarning("[Spectator] The server timed out");
+        isOver_ = true;
+    }
+}
+
+void SpectatorClient::End()
+{
+    udpSocket_.unbind();
+}
+
+void SpectatorClient::SetServerAddress(std::string_view address, unsigned short port)
+{
+    serverAddress_ = address;
+    serverPort_ = port;
+}
+
+void SpectatorClient::ReceiveNetPacket(sf::Packet& packet)
+{
+    const auto receivedPacket = GenerateReceivedPacket(packet);
+    if (!receivedPacket)
+    {
+        return;
+    }
+    if (const auto* spectateStartPacket = std::get_if<SpectateStartPacket>(&*receivedPacket))
+    {
+        StartGame(*spectateStartPacket);
+    }
+    else if (const auto* spectatorInputPacket = std::get_if<SpectatorInputPacket>(&*receivedPacket))
+    {
+        ReceiveInputPacket(*spectatorInputPacket);
+    }
+    else if (std::holds_alternative<WinGamePacket>(*receivedPacket))
+    {
+        core::LogDebug("[Spectator] The server closed the game");
+        isOver_ = true;
+    }
+}
+
+void SpectatorClient::StartGame(const SpectateStartPacket& spectateStartPacket)
+{
+    if (isStarted_ || spectateStartPacket.playerNmb == 0)
+    {
+        return;
+    }
+    gameManager_.SetPlayerNmb(spectateStartPacket.playerNmb);
+    //Spawned in the order of the server, so that the entities are the same
+    for (PlayerNumber playerNumber = 0; playerNumber < spectateStartPacket.playerNmb; playerNumber++)
+    {
+        const auto position = core::ConvertFromBinary<core::Vec2f>(spectateStartPacket.positions[playerNumber]);
+        const auto rotation = core::ConvertFromBinary<core::Degree>(spectateStartPacket.angles[playerNumber]);
+        gameManager_.SpawnPlayer(playerNumber, position, rotation);
+        gameManager_.SpawnGloves(playerNumber, position, rotation);
+    }
+    isStarted_ = true;
+    core::LogDebug(fmt::format("[Spectator] The game of {} players starts",
+        static_cast<unsigned>(spectateStartPacket.playerNmb)));
+}
+
+void SpectatorClient::ReceiveInputPacket(const SpectatorInputPacket& spectatorInputPacket)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    const auto playerNmb = gameManager_.GetPlayerNmb();
+    if (!isStarted_ || isOver_ || spectatorInputPacket.playerInputNmb != playerNmb)
+    {
+        return;
+    }
+    const auto& firstPlayerInputs = spectatorInputPacket.playerInputs[0];
+    const auto lastFrame = core::ConvertFromBinary<Frame>(firstPlayerInputs.currentFrame);
+    const auto inputNmb = firstPlayerInputs.inputNmb;
+    for (PlayerNumber playerNumber = 1; playerNumber < playerNmb; playerNumber++)
+    {
+        const auto& playerInputs = spectatorInputPacket.playerInputs[playerNumber];
+        if (playerInputs.inputNmb != inputNmb || playerInputs.currentFrame != firstPlayerInputs.currentFrame)
+        {
+            return;
+        }
+    }
+    //An old packet, or a packet after a gap that the relay fills when it sees the acknowledgements
+    const auto nextFrame = gameManager_.GetLastValidateFrame() + 1;
+    if (inputNmb == 0 || lastFrame < nextFrame || lastFrame + 1 - inputNmb > nextFrame)
+    {
+        return;
+    }
+    const auto stateFrame = core::ConvertFromBinary<Frame>(spectatorInputPacket.stateFrame);
+    for (Frame frame = nextFrame; frame <= lastFrame; frame++)
+    {
+        for (PlayerNumber playerNumber = 0; playerNumber < playerNmb; playerNumber++)
+        {
+            gameManager_.SetPlayerInput(playerNumber,
+                spectatorInputPacket.playerInputs[playerNumber].inputs[lastFrame - frame], frame);
+        }
+        //The frames are all confirmed, validating them never rolls back.
+        //Each frame is validated, so that all the spectators see the winner at the same frame.
+        gameManager_.Validate(frame);
+        if (frame == stateFrame)
+        {
+            const auto physicsState = gameManager_.GetRollbackManager().GetValidatePhysicsState();
+            const auto serverPhysicsState = core::ConvertFromBinary<PhysicsState>(spectatorInputPacket.physicsState);
+            if (physicsState != serverPhysicsState)
+            {
+                if (desyncNmb_ == 0)
+                {
+                    core::LogWarning(fmt::format("[Spectator] Desync at frame {}: server physics state {:016x}, local {:016x}",
+                        frame, serverPhysicsState, physicsState));
+                }
+                desyncNmb_++;
+            }
+        }
+        winner_ = gameManager_.CheckWinner();
+        if (winner_ != INVALID_PLAYER)
+        {
+            core::LogDebug(winner_ == DRAW_PLAYER ? fmt::format("[Spectator] Draw at frame {}", frame) :
+                fmt::format("[Spectator] P{} won at frame {}", static_cast<unsigned>(winner_) + 1, frame));
+            isOver_ = true;
+            return;
+        }
+    }
+}
+
+void SpectatorClient::SendDatagram(const char* data, std::size_t size)
+{
+    const auto status = udpSocket_.send(data, size, serverAddress_, serverPort_);
+    if (status != sf::Socket::Done && status != sf::Socket::NotReady)
+    {
+        core::LogDebug("[Spectator] Error sending UDP to server");
+    }
+}
+}
@@ -0,0 +1,292 @@
+#include <network/spectator_relay.h>
+#include "game/game_manager.h"
+#include "utils/assert.h"
+#include "utils/conversion.h"
+#include "utils/log.h"
+
+#include <fmt/format.h>
+#include <algorithm>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+void SpectatorFrames::Start(const GameManager& gameManager)
+{
+    isStarted = true;
+    playerNmb = gameManager.GetPlayerNmb();
+    const auto& transformManager = gameManager.GetTransformManager();
+    for (PlayerNumber playerNumber = 0; playerNumber < playerNmb; playerNumber++)
+    {
+        const auto entity = gameManager.GetEntityFromPlayerNumber(playerNumber);
+        spawns[playerNumber].position = transformManager.GetPosition(entity);
+        spawns[playerNumber].rotation = transformManager.GetRotation(entity);
+    }
+    lastFrame = gameManager.GetLastValidateFrame();
+    firstFrame = lastFrame + 1;
+}
+
+void SpectatorFrames::AddValidatedFrames(const GameManager& gameManager)
+{
+    if (!isStarted)
+    {
+        return;
+    }
+    const auto& rollbackManager = gameManager.GetRollbackManager();
+    const auto validateFrame = rollbackManager.GetLastValidateFrame();
+    if (validateFrame <= lastFrame)
+    {
+        return;
+    }
+    for (Frame frame = lastFrame + 1; frame <= validateFrame; frame++)
+    {
+        for (PlayerNumber playerNumber = 0; playerNumber < playerNmb; playerNumber++)
+        {
+            inputs.push_back(rollbackManager.GetInputAtFrame(playerNumber, frame));
+        }
+    }
+    lastFrame = validateFrame;
+    checkpoints.push_back({ validateFrame, rollbackManager.GetValidatePhysicsState() });
+}
+
+void SpectatorFrames::Clear()
+{
+    firstFrame = lastFrame + 1;
+    inputs.clear();
+    checkpoints.clear();
+}
+
+SpectatorRelay::SpectatorRelay(DatagramBatch& datagramBatch) : datagramBatch_(datagramBatch)
+{
+}
+
+bool SpectatorRelay::ReceiveConnectionDatagram(const ReceivedDatagram& datagram)
+{
+    if (!ReliableChannel::IsConnectionDatagram(datagram.data, datagram.size))
+    {
+        return false;
+    }
+    ReliableChannel channel;
+    bool isSpectatePacket = false;
+    channel.ReceiveDatagram(datagram.data, datagram.size, [&isSpectatePacket](sf::Packet& packet)
+    {
+        const auto receivedPacket = GenerateReceivedPacket(packet);
+        isSpectatePacket = receivedPacket && std::holds_alternative<SpectatePacket>(*receivedPacket);
+    });
+    if (!isSpectatePacket)
+    {
+        return false;
+    }
+    AddSpectator(datagram.address, datagram.port, channel);
+    return true;
+}
+
+bool SpectatorRelay::AddSpectator(sf::IpAddress address, unsigned short port, ReliableChannel& channel)
+{
+    if (spectators_.size() >= MAX_SPECTATOR_NMB)
+    {
+        core::LogWarning(fmt::format("[Spectator] Refusing the spectator with address: {} and port: {}, the relay is full",
+            address.toString(), port));
+        return false;
+    }
+    Spectator spectator;
+    spectator.address = address;
+    spectator.port = port;
+    //The channel already received the spectate packet and acknowledges it with its next Update
+    spectator.channel = std::move(channel);
+    spectator.nextFrame = firstFrame_;
+    spectators_.insert_or_assign(GetEndpointKey(address, port), std::move(spectator));
+    core::LogDebug(fmt::format("[Spectator] New spectator with address: {} and port: {}, {} spectators",
+        address.toString(), port, spectators_.size()));
+    return true;
+}
+
+bool SpectatorRelay::ReceiveDatagram(const ReceivedDatagram& datagram)
+{
+    const auto spectatorIt = spectators_.find(GetEndpointKey(datagram.address, datagram.port));
+    if (spectatorIt == spectators_.end())
+    {
+        return false;
+    }
+    auto& spectator = spectatorIt->second;
+    spectator.channel.ReceiveDatagram(datagram.data, datagram.size, [this, &spectator](sf::Packet& packet)
+    {
+        ReceiveSpectatorPacket(spectator, packet);
+    });
+    return true;
+}
+
+void SpectatorRelay::TakeFrames(SpectatorFrames& frames)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (frames.isStarted && !isStarted_)
+    {
+        isStarted_ = true;
+        playerNmb_ = frames.playerNmb;
+        firstFrame_ = frames.firstFrame;
+        broadcastFrame_ = firstFrame_ - 1;
+        for (auto& [endpointKey, spectator] : spectators_)
+        {
+            spectator.nextFrame = firstFrame_;
+        }
+
+        SpectateStartPacket startPacket;
+        startPacket.playerNmb = playerNmb_;
+        for (PlayerNumber playerNumber = 0; playerNumber < playerNmb_; playerNumber++)
+        {
+            startPacket.positions[playerNumber] = core::ConvertToBinary(frames.spawns[playerNumber].position);
+            startPacket.angles[playerNumber] = core::ConvertToBinary(frames.spawns[playerNumber].rotation);
+        }
+        serializedStartPacket_.clear();
+        GeneratePacket(serializedStartPacket_, startPacket);
+    }
+    if (isStarted_ && !frames.inputs.empty())
+    {
+        gpr_assert(frames.firstFrame == GetLastFrame() + 1, "The spectator frames need to follow the relayed ones");
+        inputs_.insert(inputs_.end(), frames.inputs.begin(), frames.inputs.end());
+        checkpoints_.insert(checkpoints_.end(), frames.checkpoints.begin(), frames.checkpoints.end());
+    }
+    frames.Clear();
+}
+
+void SpectatorRelay::Update(sf::Time dt)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    const auto lastFrame = GetLastFrame();
+    //The new frames are encoded once for all the spectators, with the previous ones to cover the lost packets
+    const bool hasNewFrames = isStarted_ && lastFrame > broadcastFrame_;
+    Frame windowFirstFrame = lastFrame + 1;
+    DatagramBatch::PayloadId payloadId = 0;
+    if (hasNewFrames)
+    {
+        windowFirstFrame = lastFrame + 1 - std::min<Frame>(MAX_INPUT_NMB, GetFrameNmb());
+        FillInputPacket(windowFirstFrame, lastFrame);
+        sendingPacket_.clear();
+        GenerateUnreliableDatagram(sendingPacket_, inputPacket_);
+        payloadId = datagramBatch_.AddPayload(sendingPacket_);
+        broadcastFrame_ = lastFrame;
+    }
+
+    for (auto spectatorIt = spectators_.begin(); spectatorIt != spectators_.end();)
+    {
+        auto& spectator = spectatorIt->second;
+        if (isStarted_ && !spectator.isStarted)
+        {
+            spectator.channel.Send(serializedStartPacket_);
+            spectator.isStarted = true;
+        }
+        if (spectator.isStarted && spectator.nextFrame <= lastFrame)
+        {
+            if (hasNewFrames && spectator.nextFrame >= windowFirstFrame)
+            {
+                datagramBatch_.QueueSend(payloadId, spectator.address, spectator.port);
+            }
+            spectator.stallTime += dt.asSeconds();
+            if (spectator.stallTime >= SPECTATOR_CATCH_UP_DELAY)
+            {
+                SendCatchUp(spectator);
+                spectator.stallTime = 0.0f;
+            }
+        }
+        SendChannelDatagrams(spectator, dt);
+        if (spectator.channel.IsTimedOut())
+        {
+            core::LogDebug(fmt::format("[Spectator] Spectator with address: {} and port: {} timed out",
+                spectator.address.toString(), spectator.port));
+            spectatorIt = spectators_.erase(spectatorIt);
+            continue;
+        }
+        ++spectatorIt;
+    }
+}
+
+void SpectatorRelay::Close()
+{
+    for (auto& [endpointKey, spectator] : spectators_)
+    {
+        spectator.channel.Send(WinGamePacket{});
+        //Last send of the win packet, nobody resends it once the spectator is removed
+        SendChannelDatagrams(spectator, sf::Time());
+    }
+    spectators_.clear();
+}
+
+void SpectatorRelay::FillInputPacket(Frame firstFrame, Frame lastFrame)
+{
+    gpr_assert(firstFrame >= firstFrame_ && lastFrame <= GetLastFrame() && lastFrame + 1 - firstFrame <= MAX_INPUT_NMB,
+        "Spectator input packet out of the relayed frames");
+    const auto inputNmb = static_cast<std::uint8_t>(lastFrame + 1 - firstFrame);
+    inputPacket_.playerInputNmb = playerNmb_;
+    for (PlayerNumber playerNumber = 0; playerNumber < playerNmb_; playerNumber++)
+    {
+        auto& playerInputPacket = inputPacket_.playerInputs[playerNumber];
+        playerInputPacket.playerNumber = playerNumber;
+        playerInputPacket.currentFrame = core::ConvertToBinary(lastFrame);
+        playerInputPacket.inputNmb = inputNmb;
+        for (std::uint8_t i = 0; i < inputNmb; i++)
+        {
+            const auto frameIndex = static_cast<std::size_t>(lastFrame - i - firstFrame_);
+            playerInputPacket.inputs[i] = inputs_[frameIndex * playerNmb_ + playerNumber];
+        }
+    }
+    //The physics state of the last validation up to lastFrame, if it is in the packet
+    const auto checkpointIt = std::upper_bound(checkpoints_.begin(), checkpoints_.end(), lastFrame,
+        [](Frame frame, const SpectatorCheckpoint& checkpoint) { return frame < checkpoint.frame; });
+    if (checkpointIt == checkpoints_.begin() || std::prev(checkpointIt)->frame < firstFrame)
+    {
+        inputPacket_.stateFrame = core::ConvertToBinary(INVALID_FRAME);
+        inputPacket_.physicsState = core::ConvertToBinary(PhysicsState{ 0 });
+        return;
+    }
+    inputPacket_.stateFrame = core::ConvertToBinary(std::prev(checkpointIt)->frame);
+    inputPacket_.physicsState = core::ConvertToBinary(std::prev(checkpointIt)->physicsState);
+}
+
+void SpectatorRelay::SendCatchUp(Spectator& spectator)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    const auto lastFrame = GetLastFrame();
+    auto firstFrame = spectator.nextFrame;
+    for (std::size_t i = 0; i < SPECTATOR_CATCH_UP_PACKET_NMB && firstFrame <= lastFrame; i++)
+    {
+        const auto packetLastFrame = std::min<Frame>(lastFrame, firstFrame + MAX_INPUT_NMB - 1);
+        FillInputPacket(firstFrame, packetLastFrame);
+        sendingPacket_.clear();
+        GenerateUnreliableDatagram(sendingPacket_, inputPacket_);
+        datagramBatch_.QueueSend(datagramBatch_.AddPayload(sendingPacket_), spectator.address, spectator.port);
+        firstFrame = packetLastFrame + 1;
+    }
+}
+
+void SpectatorRelay::ReceiveSpectatorPacket(Spectator& spectator, sf::Packet& packet) const
+{
+    const auto receivedPacket = GenerateReceivedPacket(packet);
+    if (!receivedPacket || !std::holds_alternative<SpectatorAckPacket>(*receivedPacket))
+    {
+        return;
+    }
+    const auto& ackPacket = std::get<SpectatorAckPacket>(*receivedPacket);
+    const auto nextFrame = std::min(core::ConvertFromBinary<Frame>(ackPacket.nextFrame), GetLastFrame() + 1);
+    if (nextFrame > spectator.nextFrame)
+    {
+        spectator.nextFrame = nextFrame;
+        spectator.stallTime = 0.0f;
+    }
+}
+
+void SpectatorRelay::SendChannelDatagrams(Spectator& spectator, sf::Time dt)
+{
+    spectator.channel.Update(dt, [this, &spectator](const char* data, std::size_t size)
+    {
+        datagramBatch_.QueueSend(datagramBatch_.AddPayload(data, size), spectator.address, spectator.port);
+    });
+}
+}